@@ -0,0 +1,115 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <benchmark/benchmark.h>
+
+#include <lui/string.hpp>
+
+namespace {
+
+/** The byte at a time loops String used before vectorizing. */
+namespace scalar {
+
+size_t count (const std::string& s) {
+    size_t count = 0;
+    for (size_t i = 0; i < s.length(); ++i)
+        if ((static_cast<unsigned char> (s[i]) & 0xC0) != 0x80)
+            ++count;
+    return count;
+}
+
+bool validate (const std::string& s) {
+    for (size_t i = 0; i < s.length(); ++i) {
+        unsigned char c = static_cast<unsigned char> (s[i]);
+        size_t expected = 0;
+        if ((c & 0x80) == 0)
+            expected = 0;
+        else if ((c & 0xE0) == 0xC0)
+            expected = 1;
+        else if ((c & 0xF0) == 0xE0)
+            expected = 2;
+        else if ((c & 0xF8) == 0xF0)
+            expected = 3;
+        else
+            return false;
+        for (size_t j = 0; j < expected; ++j) {
+            if (++i >= s.length() || (static_cast<unsigned char> (s[i]) & 0xC0) != 0x80)
+                return false;
+        }
+    }
+    return true;
+}
+
+size_t byte_offset (const std::string& s, size_t index) {
+    for (size_t i = 0; i < s.size(); ++i) {
+        if ((static_cast<unsigned char> (s[i]) & 0xC0) != 0x80) {
+            if (index == 0)
+                return i;
+            --index;
+        }
+    }
+    return s.size();
+}
+
+} // namespace scalar
+
+std::string make_text (size_t bytes, bool ascii) {
+    static const char* words[] = { "lorem ", "ipsum ", "dolor ", "café ", "naïve ", "中文 ", "🎉 " };
+    std::string s;
+    for (size_t i = 0; s.size() < bytes; ++i)
+        s += ascii ? words[i % 3] : words[i % 7];
+    return s;
+}
+
+void count_scalar (benchmark::State& state) {
+    const auto text = make_text (state.range (0), state.range (1) != 0);
+    for (auto _ : state)
+        benchmark::DoNotOptimize (scalar::count (text));
+    state.SetBytesProcessed (state.iterations() * text.size());
+}
+
+void count_simd (benchmark::State& state) {
+    const lui::String text (make_text (state.range (0), state.range (1) != 0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize (text.charCount());
+    state.SetBytesProcessed (state.iterations() * text.size());
+}
+
+void validate_scalar (benchmark::State& state) {
+    const auto text = make_text (state.range (0), state.range (1) != 0);
+    for (auto _ : state)
+        benchmark::DoNotOptimize (scalar::validate (text));
+    state.SetBytesProcessed (state.iterations() * text.size());
+}
+
+void validate_simd (benchmark::State& state) {
+    const lui::String text (make_text (state.range (0), state.range (1) != 0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize (text.valid_utf8());
+    state.SetBytesProcessed (state.iterations() * text.size());
+}
+
+void index_scalar (benchmark::State& state) {
+    const auto text  = make_text (state.range (0), false);
+    const auto count = scalar::count (text);
+    size_t i         = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize (scalar::byte_offset (text, (i += 7919) % count));
+}
+
+void index_sparse (benchmark::State& state) {
+    const lui::String text (make_text (state.range (0), false));
+    const auto count = text.charCount();
+    size_t i         = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize (text.byte_offset ((i += 7919) % count));
+}
+
+} // namespace
+
+BENCHMARK (count_scalar)->ArgsProduct ({ { 64, 4096, 1 << 20 }, { 0, 1 } });
+BENCHMARK (count_simd)->ArgsProduct ({ { 64, 4096, 1 << 20 }, { 0, 1 } });
+BENCHMARK (validate_scalar)->ArgsProduct ({ { 64, 4096, 1 << 20 }, { 0, 1 } });
+BENCHMARK (validate_simd)->ArgsProduct ({ { 64, 4096, 1 << 20 }, { 0, 1 } });
+BENCHMARK (index_scalar)->Arg (4096)->Arg (1 << 16);
+BENCHMARK (index_sparse)->Arg (4096)->Arg (1 << 16);
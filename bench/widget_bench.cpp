@@ -0,0 +1,236 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <lui/graphics.hpp>
+#include <lui/slider.hpp>
+#include <lui/slot_map.hpp>
+#include <lui/widget.hpp>
+
+#include "detail/pool.hpp"
+
+namespace {
+
+namespace pool = lui::detail::pool;
+
+/** Allocate and free a batch of blocks, the way rows come and go. */
+template <bool Pooled>
+void churn (benchmark::State& state) {
+    const auto size  = (size_t) state.range (0);
+    const auto count = 1024;
+    std::vector<void*> blocks (count);
+    for (auto _ : state) {
+        for (auto& b : blocks)
+            b = Pooled ? pool::allocate (size) : ::operator new (size);
+        benchmark::DoNotOptimize (blocks.data());
+        for (auto b : blocks) {
+            if (Pooled)
+                pool::deallocate (b, size);
+            else
+                ::operator delete (b);
+        }
+    }
+    state.SetItemsProcessed (state.iterations() * count);
+}
+
+void churn_pool (benchmark::State& state) { churn<true> (state); }
+void churn_heap (benchmark::State& state) { churn<false> (state); }
+
+/** A page of rows, each a widget holding a slider. */
+struct Page {
+    lui::Widget root;
+    std::vector<std::unique_ptr<lui::Widget>> rows;
+    std::vector<std::unique_ptr<lui::Slider>> sliders;
+
+    explicit Page (int count) {
+        lui::Widget::UpdateBatch batch;
+        for (int i = 0; i < count; ++i) {
+            auto& row    = *rows.emplace_back (std::make_unique<lui::Widget>());
+            auto& slider = *sliders.emplace_back (std::make_unique<lui::Slider>());
+            row.add (slider);
+            row.set_bounds (0, i * 24, 400, 24);
+            slider.set_bounds (100, 2, 300, 20);
+            root.add (row);
+        }
+    }
+};
+
+void build_page (benchmark::State& state) {
+    const auto count = (int) state.range (0);
+    for (auto _ : state) {
+        Page page (count);
+        benchmark::DoNotOptimize (&page);
+    }
+    state.SetItemsProcessed (state.iterations() * count * 2);
+}
+
+void traverse_page (benchmark::State& state) {
+    const auto count = (int) state.range (0);
+    Page page (count);
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto& s : page.sliders)
+            sum += s->to_view_space (lui::Point<int> { 1, 1 }).y + s->parent()->width();
+        benchmark::DoNotOptimize (sum);
+        // invalidate cached offsets so every lookup walks the parents.
+        page.rows.front()->set_bounds (0, 1, 400, 24);
+        page.rows.front()->set_bounds (0, 0, 400, 24);
+    }
+    state.SetItemsProcessed (state.iterations() * count);
+}
+
+/** Remove every other row of a page, then the rest, and add them back. */
+void remove_rows (benchmark::State& state) {
+    const auto count = (int) state.range (0);
+    Page page (count);
+    for (auto _ : state) {
+        lui::Widget::UpdateBatch batch;
+        for (int i = count; --i >= 0;)
+            if (i % 2 == 1)
+                page.root.remove (*page.rows[(size_t) i]);
+        for (int i = count; --i >= 0;)
+            if (i % 2 == 0)
+                page.root.remove (*page.rows[(size_t) i]);
+        for (auto& row : page.rows)
+            page.root.add (*row);
+    }
+    state.SetItemsProcessed (state.iterations() * count);
+}
+
+/** What the view does per motion event: take a reference to the widget
+    under the pointer, compare it with the hovered one and lock it.
+ */
+template <class Ref>
+void hover (benchmark::State& state) {
+    Page page (256);
+    Ref hovered = page.sliders.front().get();
+    size_t i    = 0;
+    for (auto _ : state) {
+        Ref ref = page.sliders[i++ & 255].get();
+        if (auto w = ref.lock()) {
+            if (hovered != w)
+                hovered = ref;
+            benchmark::DoNotOptimize (w);
+        }
+    }
+    state.SetItemsProcessed (state.iterations());
+}
+
+void hover_weak_ref (benchmark::State& state) { hover<lui::WidgetRef> (state); }
+void hover_handle (benchmark::State& state) { hover<lui::WidgetHandle> (state); }
+
+/** Keeps the clip and origin, draws nothing. */
+class NullContext : public lui::DrawingContext {
+public:
+    struct State {
+        lui::Bounds clip;
+    };
+    State state;
+    std::vector<State> stack;
+
+    explicit NullContext (lui::Bounds clip) { state.clip = clip; }
+
+    double device_scale() const noexcept override { return 1.0; }
+    void save() override { stack.push_back (state); }
+    void restore() override {
+        state = stack.back();
+        stack.pop_back();
+    }
+    void set_line_width (double) override {}
+    void clear_path() override {}
+    void move_to (double, double) override {}
+    void line_to (double, double) override {}
+    void quad_to (double, double, double, double) override {}
+    void cubic_to (double, double, double, double, double, double) override {}
+    void close_path() override {}
+    void fill() override {}
+    void stroke() override {}
+    void translate (double dx, double dy) override {
+        state.clip.x -= (int) dx;
+        state.clip.y -= (int) dy;
+    }
+    void transform (const lui::Transform&) override {}
+    void clip (const lui::Bounds& r) override { state.clip = state.clip.intersection (r); }
+    void exclude_clip (const lui::Bounds&) override {}
+    lui::Bounds last_clip() const override { return state.clip; }
+    lui::Font font() const noexcept override { return {}; }
+    void set_font (const lui::Font&) override {}
+    void set_fill (const lui::Fill&) override {}
+    void fill_rect (const lui::Rectangle<double>&) override {}
+    lui::FontMetrics font_metrics() const noexcept override { return {}; }
+    lui::TextMetrics text_metrics (std::string_view) const noexcept override { return {}; }
+};
+
+/** A widget that counts paints. */
+class Tile : public lui::Widget {
+public:
+    explicit Tile (bool opaque) {
+        set_opaque (opaque);
+        set_visible (true);
+    }
+    void paint (lui::Graphics&) override { ++painted; }
+    static inline int64_t painted = 0;
+};
+
+/** Render a panel of opaque cards, each holding two labels, with a clip
+    of damage pixels square.
+ */
+void render_cards (benchmark::State& state, int damage) {
+    const auto count = (int) state.range (0);
+    Tile root (false);
+    std::vector<std::unique_ptr<Tile>> cards, labels;
+    root.set_bounds (0, 0, 800, 600);
+    for (int i = 0; i < count; ++i) {
+        auto& card = *cards.emplace_back (std::make_unique<Tile> (true));
+        card.set_bounds ((i * 37) % 700, (i * 23) % 500, 100, 100);
+        for (int j = 0; j < 2; ++j) {
+            auto& label = *labels.emplace_back (std::make_unique<Tile> (false));
+            label.set_bounds (4, 4 + j * 48, 92, 44);
+            card.add (label);
+        }
+        root.add (card);
+    }
+
+    NullContext ctx ({ 100, 100, damage, damage });
+    lui::Graphics g (ctx);
+    Tile::painted = 0;
+    for (auto _ : state)
+        root.render (g);
+    state.counters["painted"] = benchmark::Counter (double (Tile::painted) / double (state.iterations()));
+    state.SetItemsProcessed (state.iterations() * count * 3);
+}
+
+void render_cards_full (benchmark::State& state) { render_cards (state, 800); }
+void render_cards_damaged (benchmark::State& state) { render_cards (state, 64); }
+
+/** Lock a stored handle to a weak referenceable object. */
+void lock_weak_handles (benchmark::State& state) {
+    Page page (256);
+    lui::WeakHandles<lui::Widget> handles;
+    std::vector<lui::SlotKey> keys;
+    for (auto& s : page.sliders)
+        keys.push_back (handles.insert (s.get()));
+    size_t i = 0;
+    for (auto _ : state) {
+        auto key = keys[i++ & 255];
+        benchmark::DoNotOptimize (handles.lock (key));
+    }
+    state.SetItemsProcessed (state.iterations());
+}
+
+} // namespace
+
+BENCHMARK (churn_pool)->Arg (32)->Arg (128)->Arg (256);
+BENCHMARK (churn_heap)->Arg (32)->Arg (128)->Arg (256);
+BENCHMARK (build_page)->Arg (100)->Arg (1000);
+BENCHMARK (traverse_page)->Arg (1000);
+BENCHMARK (remove_rows)->Arg (100)->Arg (1000);
+BENCHMARK (hover_weak_ref);
+BENCHMARK (hover_handle);
+BENCHMARK (lock_weak_handles);
+BENCHMARK (render_cards_full)->Arg (50)->Arg (500);
+BENCHMARK (render_cards_damaged)->Arg (50)->Arg (500);
@@ -147,15 +147,19 @@ void Widget::released (const Event& ev) {
 }
 
 sol::table Widget::add_with_z (const sol::object& child, int zorder) {
-    (void) zorder; /// not used yet
-    if (auto* const impl = proxy::userdata<proxy::Widget> (child))
+    if (auto* const impl = proxy::userdata<proxy::Widget> (child)) {
+        impl->set_z_order (zorder);
         lui::Widget::add (*impl);
+    }
 
     return child;
 }
 
 sol::table Widget::add (const sol::object& child) {
-    return add_with_z (child, -1);
+    if (auto* const impl = proxy::userdata<proxy::Widget> (child))
+        lui::Widget::add (*impl);
+
+    return child;
 }
 
 sol::table Widget::bounds_table() {
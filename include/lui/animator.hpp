@@ -0,0 +1,147 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <lui/widget.hpp>
+
+namespace lui {
+class Main;
+namespace detail {
+class Animator;
+} // namespace detail
+
+/** An easing curve. Maps linear progress 0-1 to eased progress.
+    @ingroup widgets
+    @headerfile lui/animator.hpp
+ */
+using Easing = double (*) (double);
+
+/** Standard easing curves.
+    @ingroup widgets
+    @headerfile lui/animator.hpp
+ */
+namespace easing {
+
+/** Constant speed. */
+inline double linear (double t) noexcept { return t; }
+
+/** Start slow. */
+inline double in_quad (double t) noexcept { return t * t; }
+
+/** End slow. */
+inline double out_quad (double t) noexcept { return t * (2.0 - t); }
+
+/** Start and end slow. */
+inline double in_out_cubic (double t) noexcept {
+    return t < 0.5 ? 4.0 * t * t * t
+                   : 1.0 + 4.0 * (t - 1.0) * (t - 1.0) * (t - 1.0);
+}
+
+} // namespace easing
+
+/** Parameters of a damped spring.
+    @ingroup widgets
+    @headerfile lui/animator.hpp
+ */
+struct Spring {
+    double stiffness { 170.0 }; ///< Pull toward the target.
+    double damping { 26.0 };    ///< Resistance to motion.
+    double mass { 1.0 };        ///< Inertia.
+    double precision { 0.001 }; ///< Distance and speed at which it settles.
+};
+
+/** Runs tweens and springs once per frame.
+
+    Every animation calls a setter with its current value each frame, or sets
+    the bounds of a widget. Animations started for a widget stop when the
+    widget is deleted. An animation's clock starts on the first frame after
+    it was added.
+
+    All repaints caused while animations are advanced are merged in to one
+    region per view. The animator only ticks while something is animating,
+    so an idle UI does no animation work.
+
+    @ingroup widgets
+    @headerfile lui/animator.hpp
+ */
+class LUI_API Animator {
+public:
+    /** Identifies an animation. Zero is never a valid ID. */
+    using ID = uint64_t;
+
+    /** Receives the current value of an animation. */
+    using Setter = std::function<void (double value)>;
+
+    /** Create an animator that isn't driven by a Main.
+        Call tick() to advance it.
+     */
+    Animator();
+
+    /** Create an animator driven by a Main's views. */
+    explicit Animator (Main& main);
+
+    ~Animator();
+
+    /** Animate a value over time.
+        @param from Start value
+        @param to End value
+        @param seconds Duration
+        @param setter Called with the value each frame
+        @param curve Easing curve
+     */
+    ID tween (double from, double to, double seconds, Setter setter, Easing curve = easing::in_out_cubic);
+
+    /** Animate a value owned by a widget. Stops if the widget is deleted. */
+    ID tween (Widget& widget, double from, double to, double seconds, Setter setter, Easing curve = easing::in_out_cubic);
+
+    /** Move and resize a widget from its current bounds.
+        Replaces any bounds animation already running on the widget.
+     */
+    ID tween_bounds (Widget& widget, Bounds target, double seconds, Easing curve = easing::in_out_cubic);
+
+    /** Animate a value with a spring until it settles at the target. */
+    ID spring (double from, double to, Setter setter, Spring params = {});
+
+    /** Animate a value owned by a widget with a spring. */
+    ID spring (Widget& widget, double from, double to, Setter setter, Spring params = {});
+
+    /** Change the target of a running animation. Springs keep their
+        velocity, tweens restart from their current value.
+        @returns false if the animation isn't running
+     */
+    bool retarget (ID id, double to);
+
+    /** Call a function when an animation finishes on its own.
+        @returns false if the animation isn't running
+     */
+    bool on_finished (ID id, std::function<void()> callback);
+
+    /** Stop an animation where it is. Returns false if it wasn't running. */
+    bool cancel (ID id);
+
+    /** Stop all animations of a widget where they are. */
+    void cancel (Widget& widget);
+
+    /** True if the animation is running. */
+    bool running (ID id) const noexcept;
+
+    /** Number of running animations. */
+    size_t size() const noexcept;
+
+    /** Advance all animations.
+        Views call this once per frame. Useful to drive animations yourself.
+        @param now Current time in seconds
+     */
+    void tick (double now);
+
+private:
+    std::shared_ptr<detail::Animator> impl;
+    LUI_DISABLE_COPY (Animator)
+};
+
+} // namespace lui
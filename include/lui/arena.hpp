@@ -0,0 +1,82 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include <lui/lui.h>
+
+namespace lui {
+
+/** Memory for objects that live no longer than one frame.
+
+    Allocation bumps a pointer through chunks taken from the heap; freeing
+    does nothing. reset() rewinds to the first chunk and keeps them all, so
+    once a frame has run, later frames of the same shape never touch the
+    heap. Use it through std::pmr containers, or FramePath.
+
+    @code
+    void paint (lui::Graphics& g) override {
+        std::pmr::vector<float> xs (&g.frame_arena());
+        lui::FramePath path (&g.frame_arena());
+        ...
+    }
+    @endcode
+
+    Not thread safe. Anything allocated is invalid after reset().
+
+    @ingroup graphics
+    @headerfile lui/arena.hpp
+ */
+class LUI_API FrameArena final : public std::pmr::memory_resource {
+public:
+    /** Allocation counts, to check painting stays off the heap. */
+    struct Stats {
+        size_t allocations { 0 };      ///< Allocations since the last reset.
+        size_t bytes { 0 };            ///< Bytes handed out since the last reset.
+        size_t heap_allocations { 0 }; ///< Chunks taken from the heap, ever.
+        size_t capacity { 0 };         ///< Bytes held in chunks.
+    };
+
+    /** Make an arena.
+        @param chunk_size Bytes taken from the heap at a time
+     */
+    explicit FrameArena (size_t chunk_size = 64 * 1024);
+    ~FrameArena();
+
+    /** Returns the arena of the calling thread. Views reset it after each
+        frame they paint.
+     */
+    static FrameArena& current() noexcept;
+
+    /** Forget everything allocated, keeping the chunks for reuse. */
+    void reset() noexcept;
+
+    /** Return all chunks to the heap. */
+    void release() noexcept;
+
+    /** Returns allocation counts. */
+    const Stats& stats() const noexcept { return _stats; }
+
+private:
+    struct Chunk {
+        std::byte* data;
+        size_t size;
+    };
+
+    std::vector<Chunk> _chunks;
+    size_t _chunk { 0 };  // chunk being allocated from
+    size_t _offset { 0 }; // used bytes in it
+    size_t _chunk_size;
+    Stats _stats;
+
+    void* do_allocate (size_t bytes, size_t alignment) override;
+    void do_deallocate (void*, size_t, size_t) override {}
+    bool do_is_equal (const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+    LUI_DISABLE_COPY (FrameArena)
+};
+
+} // namespace lui
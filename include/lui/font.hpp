@@ -6,13 +6,17 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <lui/lui.h>
 
 namespace lui {
 namespace detail {
 class Font;
-}
+class FontFallback;
+class GlyphCoverage;
+} // namespace detail
 
 /** A typeface 
     @ingroup graphics
@@ -20,12 +24,29 @@ class Font;
 */
 class LUI_API Typeface {
 public:
-    Typeface()          = default;
-    virtual ~Typeface() = default;
+    Typeface();
+    virtual ~Typeface();
     // clang-format off
     virtual std::string name() const noexcept =0;
     virtual const uint8_t* data() const noexcept =0;
     // clang-format on
+
+    /** Size of data() in bytes. Faces that return 0 report no coverage. */
+    virtual size_t size() const noexcept { return 0; }
+
+    /** Returns true if this face has a glyph for the code point.
+        Coverage is read from the font's cmap on first use, after that this
+        is a constant-time lookup.
+     */
+    bool has_glyph (uint32_t codepoint) const noexcept;
+
+    /** Load a TrueType or OpenType font file.
+        Returns nullptr if the file could not be read.
+     */
+    static std::shared_ptr<Typeface> load (const std::string& path);
+
+private:
+    mutable std::unique_ptr<detail::GlyphCoverage> _coverage;
 };
 
 /** Shared Typeface ptr.
@@ -34,6 +55,59 @@ public:
  */
 using TypefacePtr = std::shared_ptr<Typeface>;
 
+/** An ordered list of typefaces to fall back on.
+
+    The first face covering a code point is used for it. Resolution uses
+    each face's precomputed coverage and the split of a string in to runs is
+    cached, so drawing the same label again doesn't resolve it again.
+    Copies share the same list and cache.
+
+    The NanoVG backend draws and measures text run by run, with the
+    built in face ahead of the chain. Cairo's toy font API can't load faces
+    from memory, so it leaves missing glyphs to fontconfig.
+
+    @ingroup graphics
+    @headerfile lui/font.hpp
+ */
+class LUI_API FontFallback final {
+public:
+    /** A byte range of UTF-8 text drawn with one face. */
+    struct Run {
+        uint32_t start { 0 };  ///< Byte offset in the text.
+        uint32_t length { 0 }; ///< Length in bytes.
+        int face { -1 };       ///< Index of the face, or -1 if none covers it.
+    };
+
+    FontFallback();
+    ~FontFallback();
+
+    /** Append a face to the end of the chain. */
+    void add (TypefacePtr face);
+    /** Number of faces in the chain. */
+    size_t size() const noexcept;
+    /** True if there are no faces. */
+    bool empty() const noexcept;
+    /** Returns the face at index or nullptr. */
+    TypefacePtr face (size_t index) const noexcept;
+
+    /** Index of the first face covering the code point, or -1. */
+    int resolve (uint32_t codepoint) const noexcept;
+
+    /** Split UTF-8 text in to runs of a single face.
+        The returned reference is valid until the next call on this chain
+        or any copy of it.
+     */
+    const std::vector<Run>& runs (std::string_view text) const;
+
+    bool operator== (const FontFallback& o) const noexcept { return impl == o.impl; }
+    bool operator!= (const FontFallback& o) const noexcept { return impl != o.impl; }
+
+private:
+    friend class Font;
+    explicit FontFallback (std::shared_ptr<detail::FontFallback> i) : impl (std::move (i)) {}
+    std::shared_ptr<detail::FontFallback> impl;
+};
+
 /** Flag type for Font */
 using FontFlags = uint8_t;
 
@@ -101,6 +175,15 @@ public:
     */
     Font with_height (float height) const noexcept;
 
+    /** Returns the faces to try when this font lacks a glyph. */
+    FontFallback fallback() const noexcept;
+
+    /** Duplicate this font with a fallback chain.
+     
+        @param fallback Faces to try, in order, for missing glyphs.
+    */
+    Font with_fallback (const FontFallback& fallback) const noexcept;
+
     /** not reliable yet. */
     bool operator== (const Font& o) const noexcept;
     /** not reliable yet. */
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <vector>
+
+#include <lui/arena.hpp>
 #include <lui/color.hpp>
 #include <lui/fill.hpp>
 #include <lui/fitment.hpp>
@@ -10,13 +13,13 @@
 #include <lui/image.hpp>
 #include <lui/justify.hpp>
 #include <lui/lui.h>
+#include <lui/memory.hpp>
+#include <lui/path.hpp>
 #include <lui/rectangle.hpp>
 #include <lui/transform.hpp>
 
 namespace lui {
 
-class Path;
-
 /** A scoped save & restore helper. The constructor calls `save()`, the 
     destructor calls `restore()`
 */
@@ -147,6 +150,18 @@ public:
     /** Returns the text metrics for the currently selected font. */
     virtual TextMetrics text_metrics (std::string_view text) const noexcept = 0;
 
+    /** Find where each character of text starts when drawn as a whole, so
+        kerning and shaping are included.
+
+        The default measures every prefix with text_metrics(), which is
+        correct but quadratic; backends that lay out glyphs override it.
+
+        @param text UTF-8 text
+        @param xs Receives the x offset of every code point, then the advance
+                  of the whole text.
+     */
+    virtual void text_positions (std::string_view text, std::vector<float>& xs) const;
+
     /** Draw some text.
         
         Implementations should draw the text with the current font at x/y.
@@ -162,6 +177,19 @@ public:
     virtual void draw_image (Image image, Transform transform) {
         lui::ignore (image, transform);
     }
+
+    /** Add the bytes held by this context's caches and state to stats. */
+    virtual void add_memory_stats (MemoryStats& stats) const {
+        lui::ignore (stats);
+    }
+
+    /** Free cached data. Only called between frames, with the context's
+        window system context current.
+        @param level How much to free
+     */
+    virtual void trim_caches (TrimLevel level) {
+        lui::ignore (level);
+    }
 };
 
 /** Higher level graphics context.
@@ -173,13 +201,23 @@ public:
  */
 class LUI_API Graphics final {
 public:
+    /** Paint with a context, allocating from the thread's FrameArena. */
     Graphics (DrawingContext& d);
+
+    /** Paint with a context, allocating from an arena. */
+    Graphics (DrawingContext& d, FrameArena& arena);
     Graphics()  = delete;
     ~Graphics() = default;
 
     /** Returns the context used by this Graphics instance. */
     DrawingContext& context();
 
+    /** Returns memory for temporaries that live until the end of the
+        frame, such as a FramePath. It is reset after every frame, so
+        nothing allocated here may be kept past paint().
+     */
+    FrameArena& frame_arena() noexcept;
+
     /** Save the graphics state */
     void save();
 
@@ -217,6 +255,7 @@ public:
     void set_color (Color color);
 
     void fill_path (const Path& path);
+    void fill_path (const FramePath& path);
 
     /** Fill a rectangle with current color */
     void fill_rect (float x, float y, float width, float height);
@@ -249,6 +288,7 @@ public:
     void fill_rounded_rect (const Rectangle<int>& r, float corner_size);
 
     void stroke_path (const Path& path);
+    void stroke_path (const FramePath& path);
 
     /** Draw some text */
     void draw_text (const std::string& text, Rectangle<float> area, Justify align);
@@ -259,6 +299,7 @@ public:
 
 private:
     DrawingContext& _context;
+    FrameArena& _arena;
     LUI_DISABLE_COPY (Graphics)
 };
 
@@ -76,6 +76,9 @@ public:
     uint8_t* data() noexcept { return _pixels != nullptr ? _pixels->data() : nullptr; }
     bool valid() const noexcept;
     long use_count() const noexcept { return _pixels.use_count(); }
+
+    /** Returns the bytes of pixels held by every loaded image. */
+    static size_t total_bytes() noexcept;
     operator bool() const noexcept { return valid(); }
 
 private:
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <span>
 #include <sstream>
 #include <string>
 
@@ -175,6 +176,34 @@ public:
     const std::string body;
 };
 
+/** A scroll wheel or trackpad event.
+    @ingroup widgets
+    @headerfile lui/input.hpp
+*/
+struct LUI_API ScrollEvent final {
+    /** Position of the pointer in target coordinates. */
+    const Point<float> pos;
+
+    /** Distance scrolled in lines. Positive y scrolls up and positive x
+        scrolls right. Trackpads may send fractions.
+     */
+    const Point<float> delta;
+
+    /** Modifiers held while scrolling. */
+    const Modifier mods;
+
+    ScrollEvent() = delete;
+
+    /** Construct a new scroll event. You shouldn't need to use this
+        directly.
+     */
+    ScrollEvent (Point<float> position, Point<float> scroll_delta, Modifier modifiers)
+        : pos (position), delta (scroll_delta), mods (modifiers) {}
+
+private:
+    ScrollEvent& operator= (const ScrollEvent&);
+};
+
 /** An event type sent about user input.
     @ingroup widgets
 */
@@ -206,6 +235,13 @@ struct LUI_API Event final {
     /** Widget which this event now applies to */
     Widget* const target;
 
+    /** Pointer positions coalesced in to this motion or drag event, oldest
+        first and in target coordinates. The last sample is `pos`. Widgets
+        that draw strokes can use these instead of only the latest position.
+        Empty for other events, and only valid for the duration of the call.
+     */
+    const std::span<const Point<float>> samples;
+
     Event() = delete;
 
     /** Construct a new event. You shouldn't need to use this directly. This
@@ -218,6 +254,7 @@ struct LUI_API Event final {
         @param source_widget The originating widget when the event was created.
         @param target_widget The target widget event is applied to
         @param num_clicks How many clicks have been tracked at the time of creation
+        @param motion_samples Coalesced pointer positions, if any.
 
         @see Widget
     */
@@ -227,7 +264,8 @@ struct LUI_API Event final {
            Modifier modifiers,
            Widget* source_widget,
            Widget* target_widget,
-           int num_clicks)
+           int num_clicks,
+           std::span<const Point<float>> motion_samples = {})
         : pos (position),
           x (static_cast<int> (pos.x)),
           y (static_cast<int> (pos.y)),
@@ -236,7 +274,8 @@ struct LUI_API Event final {
           clicks (num_clicks),
           context (ctx),
           source (source_widget),
-          target (target_widget) {}
+          target (target_widget),
+          samples (motion_samples) {}
 
     /** Construct a new event. You shouldn't need to use this directly. This
         version uses the position as the down position.
@@ -0,0 +1,82 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace lui {
+
+/** A histogram of latencies in one millisecond buckets.
+    The last bucket collects everything at or above 100 ms.
+    @ingroup widgets
+    @headerfile lui/latency.hpp
+ */
+class LatencyHistogram {
+public:
+    /** Number of buckets. */
+    static constexpr int num_buckets = 101;
+
+    /** Width of a bucket in seconds. */
+    static constexpr double bucket_width = 0.001;
+
+    LatencyHistogram() = default;
+
+    /** Add a latency in seconds. */
+    void add (double seconds) noexcept {
+        seconds    = std::max (0.0, seconds);
+        auto index = static_cast<int> (seconds / bucket_width);
+        ++_buckets[std::min (index, num_buckets - 1)];
+        _min = _count == 0 ? seconds : std::min (_min, seconds);
+        _max = std::max (_max, seconds);
+        _total += seconds;
+        ++_count;
+    }
+
+    /** Remove all samples. */
+    void clear() noexcept { *this = {}; }
+
+    /** Number of samples. */
+    uint64_t count() const noexcept { return _count; }
+
+    /** Number of samples in a bucket. */
+    uint64_t bucket (int index) const noexcept {
+        return index >= 0 && index < num_buckets ? _buckets[index] : 0;
+    }
+
+    /** Smallest sample in seconds. */
+    double min() const noexcept { return _min; }
+
+    /** Largest sample in seconds. */
+    double max() const noexcept { return _max; }
+
+    /** Average in seconds. */
+    double mean() const noexcept { return _count > 0 ? _total / double (_count) : 0.0; }
+
+    /** Returns the latency that a fraction (0.0 - 1.0) of samples fall at or
+        below, in seconds. Accurate to one bucket.
+     */
+    double percentile (double fraction) const noexcept {
+        if (_count == 0)
+            return 0.0;
+        const auto target = std::max<uint64_t> (1, (uint64_t) std::ceil (std::clamp (fraction, 0.0, 1.0) * double (_count)));
+        uint64_t seen     = 0;
+        for (int i = 0; i < num_buckets - 1; ++i) {
+            seen += _buckets[i];
+            if (seen >= target)
+                return std::min (_max, double (i + 1) * bucket_width);
+        }
+        return _max;
+    }
+
+private:
+    uint64_t _buckets[num_buckets] {};
+    uint64_t _count { 0 };
+    double _min { 0.0 };
+    double _max { 0.0 };
+    double _total { 0.0 };
+};
+
+} // namespace lui
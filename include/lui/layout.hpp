@@ -0,0 +1,251 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <climits>
+#include <vector>
+
+#include <lui/widget.hpp>
+
+namespace lui {
+namespace detail {
+class Layout;
+} // namespace detail
+
+/** Base for widgets that place their children.
+
+    All child bounds are computed in one pass over the items and cached by
+    size, so laying out again at a size seen recently costs a lookup.
+    Results are applied in one Widget::UpdateBatch.
+    Nested layouts only solve again when their own size or items change.
+
+    Hidden items take no space and keep their bounds. Children added with
+    Widget::add() or Widget::add_all() become items with default settings.
+
+    @ingroup widgets
+    @headerfile lui/layout.hpp
+*/
+class LUI_API Layout : public Widget {
+public:
+    virtual ~Layout();
+
+    /** Set space between the edges and the items. */
+    void set_padding (int padding);
+
+    /** Returns the space between the edges and the items. */
+    int padding() const noexcept;
+
+    /** Set space between items. */
+    void set_gap (int gap);
+
+    /** Returns the space between items. */
+    int gap() const noexcept;
+
+    /** Returns the number of items. */
+    size_t num_items() const noexcept;
+
+    /** Returns the bounds of every item at a size, in item order.
+        Computed once per size until invalidated. The result is valid until
+        the next call or invalidate().
+     */
+    const std::vector<Bounds>& solve (int width, int height);
+
+    /** Discard cached results and lay out again.
+        Call after changing something that affects placement.
+     */
+    void invalidate();
+
+protected:
+    Layout();
+
+    /** Compute item bounds in an area, which is already padded.
+        @param area The space for items
+        @param bounds Set one rectangle per item. Sized to num_items() and
+                      empty to start with. Hidden items should be skipped.
+     */
+    virtual void compute (Bounds area, std::vector<Bounds>& bounds) = 0;
+
+    /** Returns the widget of an item. */
+    virtual Widget* item_widget (size_t index) const noexcept = 0;
+
+    /** Remove an item whose widget is no longer a child. */
+    virtual void erase_item (size_t index) = 0;
+
+    /** Add a default item for a child added without one. */
+    virtual void append_item (Widget& widget) = 0;
+
+    /** Returns the number of items. */
+    virtual size_t item_count() const noexcept = 0;
+
+    /** @private */
+    void resized() override;
+    /** @private */
+    void children_changed() override;
+    /** @private */
+    void child_visibility_changed (Widget* child) override;
+
+private:
+    friend class detail::Layout;
+    std::unique_ptr<detail::Layout> impl;
+    LUI_DISABLE_COPY (Layout)
+};
+
+/** How an item grows and shrinks in a FlexBox.
+    Sizes are along the main axis except cross_size.
+    @ingroup widgets
+    @headerfile lui/layout.hpp
+*/
+struct FlexItem {
+    float grow { 0.f };       ///< Share of free space taken.
+    float shrink { 1.f };     ///< Share of overflow given up, scaled by basis.
+    int basis { 0 };          ///< Size before growing or shrinking.
+    int min_size { 0 };       ///< Smallest size.
+    int max_size { INT_MAX }; ///< Largest size.
+    int cross_size { 0 };     ///< Size across, or 0 to use the full cross size.
+};
+
+/** Places children in a row or column, sized with FlexItems.
+    @ingroup widgets
+    @headerfile lui/layout.hpp
+*/
+class LUI_API FlexBox : public Layout {
+public:
+    /** Main axis. */
+    enum Direction : uint8_t {
+        ROW = 0, ///< Left to right
+        COLUMN   ///< Top to bottom
+    };
+
+    /** Placement of items when none of them grow. */
+    enum Justify : uint8_t {
+        START = 0,     ///< Packed at the start
+        CENTER,        ///< Packed in the middle
+        END,           ///< Packed at the end
+        SPACE_BETWEEN, ///< Free space between items
+        SPACE_AROUND   ///< Free space around items
+    };
+
+    /** Placement across the main axis of items with a cross size. */
+    enum Align : uint8_t {
+        ALIGN_START = 0, ///< Top or left
+        ALIGN_CENTER,    ///< Middle
+        ALIGN_END        ///< Bottom or right
+    };
+
+    FlexBox();
+    ~FlexBox();
+
+    /** Add a child widget with a default item. */
+    using Widget::add;
+
+    /** Add a child widget as an item, or change its item if it has one.
+        The layout doesn't take ownership.
+     */
+    void add (Widget& widget, FlexItem item);
+
+    /** Change the sizing of an existing item. Returns false if widget isn't one. */
+    bool set_item (Widget& widget, FlexItem item);
+
+    /** Set the main axis. */
+    void set_direction (Direction direction);
+
+    /** Returns the main axis. */
+    Direction direction() const noexcept;
+
+    /** Set placement of items along the main axis. */
+    void set_justify (Justify justify);
+
+    /** Set placement of items across the main axis. */
+    void set_align (Align align);
+
+protected:
+    /** @private */
+    void compute (Bounds area, std::vector<Bounds>& bounds) override;
+    /** @private */
+    Widget* item_widget (size_t index) const noexcept override;
+    /** @private */
+    void erase_item (size_t index) override;
+    /** @private */
+    void append_item (Widget& widget) override;
+    /** @private */
+    size_t item_count() const noexcept override;
+
+private:
+    struct Entry {
+        Widget* widget;
+        FlexItem item;
+    };
+    std::vector<Entry> _items;
+    std::vector<size_t> _shown;
+    std::vector<float> _sizes;
+    std::vector<bool> _frozen;
+    Direction _direction { ROW };
+    Justify _justify { START };
+    Align _align { ALIGN_START };
+    LUI_DISABLE_COPY (FlexBox)
+};
+
+/** A row or column size in a Grid.
+    @ingroup widgets
+    @headerfile lui/layout.hpp
+*/
+struct GridTrack {
+    float size { 1.f };     ///< Pixels or a share of the space left.
+    bool fraction { true }; ///< True if size is a share.
+
+    /** A fixed size track. */
+    static GridTrack pixels (int size) noexcept { return { (float) size, false }; }
+
+    /** A track sharing the space left after fixed tracks. */
+    static GridTrack share (float weight = 1.f) noexcept { return { weight, true }; }
+};
+
+/** Places children in the cells of a grid of fixed and shared tracks.
+    @ingroup widgets
+    @headerfile lui/layout.hpp
+*/
+class LUI_API Grid : public Layout {
+public:
+    Grid();
+    ~Grid();
+
+    /** Set the column tracks. */
+    void set_columns (std::vector<GridTrack> columns);
+
+    /** Set the row tracks. */
+    void set_rows (std::vector<GridTrack> rows);
+
+    /** Add a child widget in the cell after the last item, row by row. */
+    using Widget::add;
+
+    /** Add a child widget spanning cells, or move it if already an item.
+        The layout doesn't take ownership. Cells outside the tracks get
+        empty bounds.
+     */
+    void add (Widget& widget, int column, int row, int column_span = 1, int row_span = 1);
+
+protected:
+    /** @private */
+    void compute (Bounds area, std::vector<Bounds>& bounds) override;
+    /** @private */
+    Widget* item_widget (size_t index) const noexcept override;
+    /** @private */
+    void erase_item (size_t index) override;
+    /** @private */
+    void append_item (Widget& widget) override;
+    /** @private */
+    size_t item_count() const noexcept override;
+
+private:
+    struct Entry {
+        Widget* widget;
+        int column, row, columns, rows;
+    };
+    std::vector<Entry> _items;
+    std::vector<GridTrack> _columns, _rows;
+    std::vector<int> _column_edges, _row_edges;
+    LUI_DISABLE_COPY (Grid)
+};
+
+} // namespace lui
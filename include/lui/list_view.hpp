@@ -0,0 +1,122 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <memory>
+
+#include <lui/widget.hpp>
+
+namespace lui {
+namespace detail {
+class ListView;
+} // namespace detail
+
+/** Supplies rows to a ListView.
+    @ingroup widgets
+    @headerfile lui/list_view.hpp
+*/
+class LUI_API ListModel {
+public:
+    virtual ~ListModel() = default;
+
+    /** Returns the number of rows. */
+    virtual int num_rows() const = 0;
+
+    /** Returns the height of a row in pixels. */
+    virtual int row_height (int row) const {
+        lui::ignore (row);
+        return 24;
+    }
+
+    /** Create a widget that can display any row. Only called for as many
+        widgets as it takes to fill the list.
+     */
+    virtual std::unique_ptr<Widget> create_row() = 0;
+
+    /** Show a row in a widget made by create_row(). Widgets are recycled as
+        the list scrolls, so this may be a widget last used for another row.
+     */
+    virtual void update_row (Widget& widget, int row) = 0;
+};
+
+/** A scrolling list that only creates widgets for visible rows.
+
+    Rows come from a ListModel which is only asked about rows as they scroll
+    in to view, except for row heights which are collected when refreshed.
+    Heights are kept in a prefix sum index, so finding the row at any
+    position or the position of any row is O(log n). Multi-column tables
+    are rows whose widgets lay out their own cells.
+
+    @ingroup widgets
+    @headerfile lui/list_view.hpp
+*/
+class LUI_API ListView : public Widget {
+public:
+    ListView();
+    virtual ~ListView();
+
+    /** Set the model. The list doesn't take ownership.
+        @param model The model or nullptr to clear it.
+     */
+    void set_model (ListModel* model);
+
+    /** Returns the model, or nullptr. */
+    ListModel* model() const noexcept;
+
+    /** Call when the number of rows or their contents change. Re-reads
+        every row height and updates visible rows.
+     */
+    void refresh();
+
+    /** Call when the height of a single row changes. */
+    void row_height_changed (int row);
+
+    /** Call when the contents of a single row change. */
+    void row_changed (int row);
+
+    /** Returns the number of rows. */
+    int num_rows() const noexcept;
+
+    /** Returns the total height of all rows. */
+    int content_height() const noexcept;
+
+    /** Returns the row at y in content coordinates, or -1. */
+    int row_at (int y) const noexcept;
+
+    /** Returns the top of a row in content coordinates. */
+    int row_position (int row) const noexcept;
+
+    /** Scroll so content coordinate y is at the top. */
+    void set_scroll_position (int y);
+
+    /** Returns the content coordinate at the top. */
+    int scroll_position() const noexcept;
+
+    /** Scroll a row to the top. */
+    void scroll_to_row (int row);
+
+    /** Returns the widget showing a row, or nullptr if it isn't visible. */
+    Widget* row_widget (int row) const noexcept;
+
+    /** Returns how many row widgets have been created. */
+    int num_row_widgets() const noexcept;
+
+    /** Change how many pixels one line of scrolling moves. */
+    void set_scroll_step (int pixels);
+
+protected:
+    /** @private */
+    bool obstructed (int, int) override { return true; }
+    /** @private */
+    bool scroll (const ScrollEvent& ev) override;
+    /** @private */
+    void resized() override;
+
+private:
+    friend class detail::ListView;
+    std::unique_ptr<detail::ListView> impl;
+    LUI_DISABLE_COPY (ListView)
+};
+
+} // namespace lui
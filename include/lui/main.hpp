@@ -3,20 +3,27 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include <lui/lui.h>
 
 #include <lui/context.hpp>
+#include <lui/memory.hpp>
 #include <lui/view.hpp>
 
 namespace lui {
+class Animator;
 class Backend;
 class Style;
 class Widget;
 namespace detail {
+class Animator;
 class Main;
 class View;
 class Widget;
@@ -105,6 +112,47 @@ public:
     /** Request the main loop stop running. */
     void quit();
 
+    /** Largest callable, in bytes, that can be passed to post(). */
+    static constexpr size_t max_post_size = 48;
+
+    /** Run a function on the UI thread.
+
+        Safe to call from any thread, including realtime audio threads. The
+        callable is moved in to a preallocated slot of a lock-free queue, so
+        nothing is allocated or locked. Posted functions run in order, in
+        batches, from loop() and from each view's timer. In a standalone
+        program the first post after a batch also wakes the loop: that
+        writes a byte to a pipe (an event on Windows) for a helper thread,
+        which then sends the loop an event. Send small messages by
+        capturing them by value.
+
+        @param fn A nothrow movable callable no larger than max_post_size.
+        @returns false if the queue is full and fn was dropped.
+     */
+    template <class Fn>
+    bool post (Fn&& fn) {
+        using F = std::decay_t<Fn>;
+        static_assert (sizeof (F) <= max_post_size, "callable is too large to post");
+        static_assert (alignof (F) <= alignof (std::max_align_t), "callable is over aligned");
+        static_assert (std::is_nothrow_move_constructible_v<F>, "callable must be nothrow movable");
+
+        F source (std::forward<Fn> (fn));
+        return post_internal (
+            [] (void* storage, bool run) {
+                // destroyed even if it throws.
+                struct Destroy {
+                    F* f;
+                    ~Destroy() { f->~F(); }
+                } destroy { static_cast<F*> (storage) };
+                if (run)
+                    (*destroy.f)();
+            },
+            [] (void* storage, void* src) {
+                new (storage) F (std::move (*static_cast<F*> (src)));
+            },
+            &source);
+    }
+
     /** Elevate a Widget to view with optional opaque parent */
     View* elevate (Widget& widget, ViewFlags flags, uintptr_t parent);
 
@@ -114,6 +162,9 @@ public:
     /** Find the view for this wiget */
     View* find_view (Widget& widget) const noexcept;
 
+    /** Returns the animator run by this context's views. */
+    Animator& animator() noexcept;
+
     /** Returns the default style
         @returns Style
      */
@@ -124,6 +175,24 @@ public:
      */
     const Style& style() const noexcept;
 
+    /** Returns the memory held by images, the drawing contexts of this
+        context's views, their widget trees, and the calling thread's widget
+        pool and frame arena. Call from the UI thread.
+     */
+    MemoryStats memory_stats() const;
+
+    /** Free caches until MemoryStats::caches() is at most budget.
+
+        Cheap to rebuild data goes first: scratch buffers, then shaped text
+        and image textures, then font atlases. Everything freed is rebuilt
+        when next drawn, so trim when views are hidden or idle, e.g. when a
+        plugin window closes. Call from the UI thread, outside of painting.
+
+        @param budget Bytes of caches to keep, 0 to free all.
+        @returns The memory held after trimming.
+     */
+    MemoryStats trim_memory (size_t budget = 0);
+
     /** Returns the OS System Object.
         X11: Returns a pointer to the `Display`.
         MacOS: Returns a pointer to the `NSApplication`.
@@ -136,8 +205,11 @@ private:
     friend class detail::Widget;
     friend class View;
     friend class detail::View;
+    friend class detail::Animator;
 
     std::unique_ptr<detail::Main> impl;
+
+    bool post_internal (void (*handler) (void*, bool), void (*construct) (void*, void*), void* source) noexcept;
     LUI_DISABLE_COPY (Main)
 };
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstring>
 #include <type_traits>
 
@@ -32,4 +33,40 @@ static auto to_chars (Val value) {
     return result;
 }
 
+/** Bytes of memory held, by what holds them.
+    @see Main::memory_stats
+    @ingroup widgets
+    @headerfile lui/memory.hpp
+ */
+struct MemoryStats {
+    size_t images { 0 };         ///< Decoded image pixels, shared by every Main.
+    size_t image_cache { 0 };    ///< Backend copies of images, such as textures.
+    size_t font_atlas { 0 };     ///< Rasterized glyphs, and their textures.
+    size_t path_cache { 0 };     ///< Backend path buffers and shaped text.
+    size_t context_stacks { 0 }; ///< Saved drawing states.
+    size_t frame_arena { 0 };    ///< Chunks of the calling thread's FrameArena.
+    size_t widgets { 0 };        ///< Widget internals, child lists and render lists.
+    size_t num_widgets { 0 };    ///< Widgets in the trees of the views.
+    size_t pool { 0 };           ///< Pool chunks of the calling thread, which hold most widget internals.
+
+    /** Bytes that trimming can free. */
+    size_t caches() const noexcept {
+        return image_cache + font_atlas + path_cache + context_stacks + frame_arena;
+    }
+
+    /** Bytes of everything except the pool, which overlaps widgets. */
+    size_t total() const noexcept { return images + caches() + widgets; }
+};
+
+/** How much to free when trimming caches. Each level includes the ones
+    before it and costs more to rebuild when next drawn.
+    @ingroup widgets
+    @headerfile lui/memory.hpp
+ */
+enum class TrimLevel : int {
+    SCRATCH = 0, ///< Buffers regrown on the next frame: paths, state stacks, arenas
+    CACHES,      ///< Shaped text and image textures, uploaded again when drawn
+    ALL          ///< Font atlases too, glyphs are rasterized again when drawn
+};
+
 } // namespace lui
@@ -14,7 +14,7 @@ namespace lui {
 enum class Notify : uint32_t {
     NONE = 0, ///< Don't send any notification
     SYNC,     ///< Send notification sync
-    ASYNC     ///< Send notification async
+    ASYNC     ///< Send notification later from the event loop
 };
 
 } // namespace lui
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <memory_resource>
 #include <vector>
 
 #include <lui/rectangle.hpp>
@@ -43,27 +44,34 @@ struct PathItem final {
 };
 
 /** Drawable path.
+    Use the Path and FramePath aliases.
+    @tparam Alloc Allocator of the float data
     @ingroup graphics
     @headerfile lui/path.hpp
 */
-class Path {
+template <class Alloc>
+class BasicPath {
 public:
-    using value_type = PathItem;
+    using value_type     = PathItem;
+    using allocator_type = Alloc;
 
     /** Make an empty path */
-    Path()  = default;
-    ~Path() = default;
+    BasicPath()  = default;
+    ~BasicPath() = default;
+
+    /** Make an empty path using an allocator */
+    explicit BasicPath (const Alloc& alloc) : _data (alloc) {}
 
     /** Copy a path */
-    Path (const Path& o) { operator= (o); }
-    Path& operator= (const Path& o) {
+    BasicPath (const BasicPath& o) { operator= (o); }
+    BasicPath& operator= (const BasicPath& o) {
         std::copy (o._data.begin(), o._data.end(), _data.begin());
         return *this;
     }
 
     /** Move a path */
-    Path (Path&& o) : _data (std::move (o._data)) {}
-    Path& operator= (Path&& o) {
+    BasicPath (BasicPath&& o) : _data (std::move (o._data)) {}
+    BasicPath& operator= (BasicPath&& o) {
         this->_data = std::move (o._data);
         return *this;
     }
@@ -166,9 +174,10 @@ public:
         bool operator!= (const iterator& o) { return _i != o._i; };
 
     private:
-        friend class Path;
-        explicit iterator (std::vector<float>::const_iterator i) : _i (i) {}
-        std::vector<float>::const_iterator _i;
+        friend class BasicPath;
+        using data_iterator = typename std::vector<float, Alloc>::const_iterator;
+        explicit iterator (data_iterator i) : _i (i) {}
+        data_iterator _i;
         value_type _item;
     };
 
@@ -202,7 +211,7 @@ public:
     }
 
 private:
-    std::vector<float> _data;
+    std::vector<float, Alloc> _data;
     template <typename T>
     void add_op (T v) { _data.push_back (static_cast<float> (v)); }
     template <typename T, typename... Args>
@@ -212,6 +221,21 @@ private:
     }
 };
 
+/** A path on the heap.
+    @ingroup graphics
+    @headerfile lui/path.hpp
+*/
+using Path = BasicPath<std::allocator<float>>;
+
+/** A path in a FrameArena, for building while painting.
+    @code
+    lui::FramePath path (&g.frame_arena());
+    @endcode
+    @ingroup graphics
+    @headerfile lui/path.hpp
+*/
+using FramePath = BasicPath<std::pmr::polymorphic_allocator<float>>;
+
 namespace graphics {
 
 /** Add a rounded rectangle to something.
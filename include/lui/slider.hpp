@@ -4,10 +4,12 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 
 #include <lui/lui.h>
 #include <lui/notify.hpp>
 #include <lui/range.hpp>
+#include <lui/value_channel.hpp>
 #include <lui/widget.hpp>
 
 // clang-format off
@@ -41,7 +43,10 @@ public:
 
     /** Set the current value
         @param value New value
-        @param notify How to notify 
+        @param notify How to notify. With Notify::ASYNC the value is set
+                      later from the event loop, so it may be called from
+                      any thread. A value set while the widget has no view
+                      is applied once it is shown in one.
     */
     void set_value (double value, Notify notify);
 
@@ -56,6 +61,21 @@ public:
     */
     const Range<double>& range() const noexcept;
 
+    /** Follow a value written by another thread, such as a level from the
+        audio thread. The channel is polled once per frame and the value is
+        set, without notification, when it moved more than threshold.
+        @param channel Channel to follow or nullptr to stop following
+        @param threshold Smallest change that updates the widget
+    */
+    void bind (std::shared_ptr<ValueChannel<double>> channel, double threshold = 0.0);
+
+    /** @returns the channel being followed or nullptr */
+    ValueChannel<double>* bound_channel() const noexcept;
+
+protected:
+    /** @private */
+    void parent_structure_changed() override;
+
 private:
     friend class detail::Ranged;
     std::unique_ptr<detail::Ranged> impl;
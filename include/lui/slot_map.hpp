@@ -0,0 +1,165 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <lui/weak_ref.hpp>
+
+namespace lui {
+
+/** A key into a SlotMap: a slot index and the generation of the value
+    it was issued for. A default key never refers to a value.
+ */
+struct SlotKey {
+    uint32_t index { 0 };
+    uint32_t generation { 0 };
+
+    bool operator== (const SlotKey& o) const noexcept {
+        return index == o.index && generation == o.generation;
+    }
+    bool operator!= (const SlotKey& o) const noexcept { return ! operator== (o); }
+};
+
+/** Values stored in reusable slots and found by SlotKey.
+
+    Erasing a value bumps its slot's generation, so stale keys find nothing
+    even after the slot is reused. Lookups are an index and a compare with
+    no reference counting. Not thread safe.
+ */
+template <class V>
+class SlotMap {
+public:
+    using Key = SlotKey;
+
+    SlotMap() = default;
+
+    /** Store a value. Returns its key. */
+    Key insert (V value) {
+        uint32_t index;
+        if (_free != npos) {
+            index = _free;
+            _free = _slots[index].next_free;
+        } else {
+            index = static_cast<uint32_t> (_slots.size());
+            _slots.emplace_back();
+        }
+
+        auto& slot    = _slots[index];
+        slot.value    = std::move (value);
+        slot.occupied = true;
+        ++_size;
+        return { index, slot.generation };
+    }
+
+    /** Remove a value. Returns false if key is stale. */
+    bool erase (Key key) {
+        if (! contains (key))
+            return false;
+        auto& slot    = _slots[key.index];
+        slot.value    = V();
+        slot.occupied = false;
+        if (++slot.generation == 0)
+            slot.generation = 1;
+        slot.next_free = _free;
+        _free          = key.index;
+        --_size;
+        return true;
+    }
+
+    /** Remove every value for which pred returns true. */
+    template <class Pred>
+    size_t erase_if (Pred pred) {
+        size_t count = 0;
+        for (uint32_t i = 0; i < _slots.size(); ++i)
+            if (_slots[i].occupied && pred (_slots[i].value))
+                count += erase ({ i, _slots[i].generation }) ? 1 : 0;
+        return count;
+    }
+
+    /** Returns the value of key, or nullptr if stale. */
+    V* find (Key key) noexcept {
+        return contains (key) ? &_slots[key.index].value : nullptr;
+    }
+
+    /** Returns the value of key, or nullptr if stale. */
+    const V* find (Key key) const noexcept {
+        return contains (key) ? &_slots[key.index].value : nullptr;
+    }
+
+    /** Returns true if key refers to a value. */
+    bool contains (Key key) const noexcept {
+        return key.index < _slots.size()
+               && _slots[key.index].occupied
+               && _slots[key.index].generation == key.generation;
+    }
+
+    /** Number of values. */
+    size_t size() const noexcept { return _size; }
+
+    /** Returns true if there are no values. */
+    bool empty() const noexcept { return _size == 0; }
+
+private:
+    static constexpr uint32_t npos = ~uint32_t (0);
+
+    struct Slot {
+        V value {};
+        uint32_t generation { 1 };
+        uint32_t next_free { npos };
+        bool occupied { false };
+    };
+
+    std::vector<Slot> _slots;
+    uint32_t _free { npos };
+    size_t _size { 0 };
+};
+
+/** Handles to objects that are already weak referenceable.
+
+    Adapts a class using LUI_WEAK_REFABLE to SlotKey handles. The WeakRef is
+    copied once on insert; copying a handle afterwards is copying two
+    integers and lock() never touches a reference count.
+
+    @code
+    lui::WeakHandles<MyObject> handles;
+    auto key = handles.insert (object);
+    if (auto obj = handles.lock (key))
+        obj->do_something();
+    @endcode
+
+    @see WeakRef, LUI_WEAK_REFABLE
+ */
+template <class Obj>
+class WeakHandles {
+public:
+    /** Add an object. Returns its handle. */
+    SlotKey insert (Obj* obj) { return _refs.insert (WeakRef<Obj> (obj)); }
+
+    /** Forget a handle. */
+    bool erase (SlotKey key) { return _refs.erase (key); }
+
+    /** Returns the object, or nullptr if the handle is stale or the object
+        was deleted.
+     */
+    Obj* lock (SlotKey key) const noexcept {
+        auto ref = _refs.find (key);
+        return ref != nullptr ? ref->lock() : nullptr;
+    }
+
+    /** Free the slots of deleted objects. Returns the number freed. */
+    size_t purge() {
+        return _refs.erase_if ([] (const WeakRef<Obj>& ref) { return ! ref.valid(); });
+    }
+
+    /** Number of handles, including any to deleted objects not purged. */
+    size_t size() const noexcept { return _refs.size(); }
+
+private:
+    SlotMap<WeakRef<Obj>> _refs;
+};
+
+} // namespace lui
@@ -7,11 +7,21 @@
 #include <cctype>
 #include <cstdint>
 #include <cstring>
+#include <memory>
+#include <vector>
 
 #if __has_include(<format>)
 #    include <format>
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define LUI_STRING_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define LUI_STRING_NEON 1
+#endif
+
 #include <string>
 
 namespace lui {
@@ -35,15 +45,20 @@ public:
     String (const char* str) : _str (str) {}
     /** Create a string from a std::string */
     String (const std::string& o) : _str (o) {}
+    /** Destructor */
+    ~String() = default;
     /** Copy constructor */
     String (const String& o) : _str (o._str) {}
     /** Move constructor */
     String (std::string&& o) noexcept : _str (std::move (o)) {}
     /** Move constructor from another String */
-    String (String&& o) noexcept : _str (std::move (o._str)) {}
+    String (String&& o) noexcept : _str (std::move (o._str)) { o.changed(); }
 
     /** Clear this string. */
-    void clear() { _str.clear(); }
+    void clear() {
+        _str.clear();
+        changed();
+    }
 
     /** Return the byte length of the string (not character count). 
         Use charCount() to get the number of UTF-8 code points. */
@@ -57,15 +72,7 @@ public:
         Note: This is different from length() which returns bytes. 
         For multi-byte UTF-8 characters, charCount() will be less than length(). */
     size_t charCount() const noexcept {
-        size_t count = 0;
-        for (size_t i = 0; i < _str.length(); ++i) {
-            unsigned char c = static_cast<unsigned char> (_str[i]);
-            // Count bytes that are not continuation bytes (10xxxxxx)
-            if ((c & 0xC0) != 0x80) {
-                ++count;
-            }
-        }
-        return count;
+        return count_utf8 (_str.data(), _str.size());
     }
 
     /** Check if string is empty. */
@@ -73,10 +80,103 @@ public:
 
     /** Validate UTF-8 encoding. Returns true if valid. */
     bool valid_utf8() const noexcept {
-        for (size_t i = 0; i < _str.length(); ++i) {
-            unsigned char c              = static_cast<unsigned char> (_str[i]);
-            size_t expected_continuation = 0;
+        return validate_utf8 (_str.data(), _str.size());
+    }
+
+    /** Returns the byte offset of the code point at char_index.
+        Returns length() if char_index is past the end.
+
+        Long strings build a sparse code point to byte index on first use,
+        so repeated lookups are constant-time instead of a scan from the
+        start. Any modification discards the index. Not thread safe.
+     */
+    size_t byte_offset (size_t char_index) const {
+        const char* data = _str.data();
+        const auto size  = _str.size();
+        size_t pos       = 0;
+
+        if (size >= index_stride * 4) {
+            if (_index == nullptr)
+                build_index();
+            const auto block = char_index / index_stride;
+            if (block >= _index->size())
+                return size;
+            pos = (*_index)[block];
+            char_index -= block * index_stride;
+        }
 
+        for (; pos < size; ++pos) {
+            if ((static_cast<unsigned char> (data[pos]) & 0xC0) != 0x80) {
+                if (char_index == 0)
+                    return pos;
+                --char_index;
+            }
+        }
+        return size;
+    }
+
+    /** Count code points in a UTF-8 buffer.
+        Counts every byte that isn't a continuation byte, 64 at a time where
+        SIMD is available.
+     */
+    static size_t count_utf8 (const char* data, size_t size) noexcept {
+        size_t continuations = 0;
+        size_t i             = 0;
+#if LUI_STRING_SSE2
+        // Per-lane byte counters, summed before they can overflow.
+        const auto limit = _mm_set1_epi8 (-64); // continuation bytes are < 0xC0 as signed
+        while (i + 64 <= size) {
+            auto acc         = _mm_setzero_si128();
+            const auto chunk = std::min ((size - i) / 64, size_t (63));
+            for (size_t n = 0; n < chunk; ++n, i += 64) {
+                const auto p = reinterpret_cast<const __m128i*> (data + i);
+                acc          = _mm_sub_epi8 (acc, _mm_cmplt_epi8 (_mm_loadu_si128 (p), limit));
+                acc          = _mm_sub_epi8 (acc, _mm_cmplt_epi8 (_mm_loadu_si128 (p + 1), limit));
+                acc          = _mm_sub_epi8 (acc, _mm_cmplt_epi8 (_mm_loadu_si128 (p + 2), limit));
+                acc          = _mm_sub_epi8 (acc, _mm_cmplt_epi8 (_mm_loadu_si128 (p + 3), limit));
+            }
+            const auto sum = _mm_sad_epu8 (acc, _mm_setzero_si128());
+            continuations += static_cast<size_t> (_mm_cvtsi128_si32 (sum) + _mm_extract_epi16 (sum, 4));
+        }
+#elif LUI_STRING_NEON
+        while (i + 16 <= size) {
+            auto acc         = vdupq_n_u8 (0);
+            const auto chunk = std::min ((size - i) / 16, size_t (255));
+            for (size_t n = 0; n < chunk; ++n, i += 16) {
+                const auto v = vld1q_u8 (reinterpret_cast<const uint8_t*> (data + i));
+                acc          = vsubq_u8 (acc, vcltq_s8 (vreinterpretq_s8_u8 (v), vdupq_n_s8 (-64)));
+            }
+            continuations += vaddlvq_u8 (acc);
+        }
+#endif
+        for (; i < size; ++i)
+            if ((static_cast<unsigned char> (data[i]) & 0xC0) == 0x80)
+                ++continuations;
+        return size - continuations;
+    }
+
+    /** Validate a UTF-8 buffer.
+        Runs of ASCII are skipped 16 bytes at a time where SIMD is available,
+        multi-byte sequences are checked one at a time.
+     */
+    static bool validate_utf8 (const char* data, size_t size) noexcept {
+        const auto bytes = reinterpret_cast<const unsigned char*> (data);
+        size_t i         = 0;
+        while (i < size) {
+#if LUI_STRING_SSE2
+            if (i + 16 <= size
+                && _mm_movemask_epi8 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (bytes + i))) == 0) {
+                i += 16;
+                continue;
+            }
+#elif LUI_STRING_NEON
+            if (i + 16 <= size && vmaxvq_u8 (vld1q_u8 (bytes + i)) < 0x80) {
+                i += 16;
+                continue;
+            }
+#endif
+            const auto c = bytes[i];
+            size_t expected_continuation;
             if ((c & 0x80) == 0) {
                 // Single byte character (0xxxxxxx)
                 expected_continuation = 0;
@@ -94,16 +194,12 @@ public:
                 return false;
             }
 
-            for (size_t j = 0; j < expected_continuation; ++j) {
-                ++i;
-                if (i >= _str.length()) {
-                    return false;
-                }
-                unsigned char cont = static_cast<unsigned char> (_str[i]);
-                if ((cont & 0xC0) != 0x80) {
+            if (i + expected_continuation >= size && expected_continuation > 0)
+                return false;
+            for (size_t j = 1; j <= expected_continuation; ++j)
+                if ((bytes[i + j] & 0xC0) != 0x80)
                     return false;
-                }
-            }
+            i += expected_continuation + 1;
         }
         return true;
     }
@@ -113,24 +209,28 @@ public:
     /** Append another String to this one */
     String& append (const String& o) {
         _str.append (o._str);
+        changed();
         return *this;
     }
 
     /** Append a std::string to this one */
     String& append (const std::string& o) {
         _str.append (o);
+        changed();
         return *this;
     }
 
     /** Append a C string to this one */
     String& append (const char* o) {
         _str.append (o);
+        changed();
         return *this;
     }
 
     /** append a single char. */
     String& append (char c) {
         _str.append (1, c);
+        changed();
         return *this;
     }
 
@@ -140,6 +240,7 @@ public:
         return append_formatted ("{}", i);
 #else
         _str.append (std::to_string (i));
+        changed();
         return *this;
 #endif
     }
@@ -150,6 +251,7 @@ public:
         return append_formatted ("{}", i);
 #else
         _str.append (std::to_string (i));
+        changed();
         return *this;
 #endif
     }
@@ -160,6 +262,7 @@ public:
         return append_formatted ("{}", i);
 #else
         _str.append (std::to_string (i));
+        changed();
         return *this;
 #endif
     }
@@ -170,6 +273,7 @@ public:
         return append_formatted ("{}", i);
 #else
         _str.append (std::to_string (i));
+        changed();
         return *this;
 #endif
     }
@@ -185,6 +289,7 @@ public:
     template <typename... Args>
     String& append_formatted (std::format_string<Args...> fmt, Args&&... args) {
         _str.append (std::format (fmt, std::forward<Args> (args)...));
+        changed();
         return *this;
     }
 #endif
@@ -308,6 +413,7 @@ public:
             _str.replace (pos, search.length(), replacement);
             pos += replacement.length();
         }
+        changed();
         return *this;
     }
 
@@ -347,6 +453,7 @@ public:
     String& operator= (const String& o) {
         if (this != &o) {
             _str = o._str;
+            changed();
         }
         return *this;
     }
@@ -355,23 +462,28 @@ public:
     String& operator= (String&& o) noexcept {
         if (this != &o) {
             _str = std::move (o._str);
+            changed();
+            o.changed();
         }
         return *this;
     }
 
     String& operator= (const str_type& o) {
         _str = o;
+        changed();
         return *this;
     }
 
     /** Move assignment from std::string */
     String& operator= (str_type&& o) noexcept {
         _str = std::move (o);
+        changed();
         return *this;
     }
 
     String& operator= (const char* o) {
         _str = o;
+        changed();
         return *this;
     }
 
@@ -409,6 +521,26 @@ public:
 
 private:
     std::string _str;
+
+    /** Byte offset of every index_stride'th code point. */
+    static constexpr size_t index_stride = 64;
+    mutable std::unique_ptr<std::vector<size_t>> _index;
+
+    void changed() noexcept { _index.reset(); }
+
+    void build_index() const {
+        auto index = std::make_unique<std::vector<size_t>>();
+        index->reserve (_str.size() / index_stride + 1);
+        size_t n = 0;
+        for (size_t i = 0; i < _str.size(); ++i) {
+            if ((static_cast<unsigned char> (_str[i]) & 0xC0) != 0x80) {
+                if (n % index_stride == 0)
+                    index->push_back (i);
+                ++n;
+            }
+        }
+        _index = std::move (index);
+    }
 };
 
 #define APPEND(t)                                          \
@@ -3,7 +3,10 @@
 
 #pragma once
 
-#include <set>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
 
 #include <lui/lui.h>
 
@@ -13,6 +16,21 @@
 
 namespace lui {
 
+namespace detail {
+class Main;
+
+/** Style entries by ID. IDs up to max_flat index an array, larger ones
+    are kept in a map so a big custom ID doesn't size the array.
+    @private
+ */
+template <class T>
+struct StyleTable {
+    static constexpr int max_flat = 1023;
+    std::vector<T> flat;
+    std::unordered_map<int, T> sparse;
+};
+} // namespace detail
+
 class Button;
 class Graphics;
 class Slider;
@@ -45,7 +63,43 @@ struct ColorID final {
     };
 };
 
+/** MetricID's for sizes used when drawing
+    @ingroup widgets
+    @headerfile lui/style.hpp
+*/
+struct MetricID final {
+    MetricID()  = delete;
+    ~MetricID() = delete;
+    enum : int {
+        CORNER_SIZE = 1,    ///< Corner size of rounded shapes
+        LINE_WIDTH,         ///< Width of outlines
+        SLIDER_TRACK_SIZE,  ///< Thickness of the groove the thumb slides in
+        SLIDER_THUMB_SIZE,  ///< Width and height of the slider handle
+        SLIDER_THUMB_CORNER ///< Corner size of the slider handle
+    };
+};
+
+/** FontID's for theming
+    @ingroup widgets
+    @headerfile lui/style.hpp
+*/
+struct FontID final {
+    FontID()  = delete;
+    ~FontID() = delete;
+    enum : int {
+        DEFAULT = 1, ///< Text with no more specific font
+        BUTTON       ///< Button text, shrunk to fit short buttons
+    };
+};
+
 /** Style used to draw common widgets.
+
+    Colors, metrics and fonts are kept in flat tables indexed by ID, so a
+    lookup is an array access. IDs above 1023 fall back to a map. Every
+    change bumps version(). Lookups made while a widget paints are
+    remembered for that widget; when an entry changes only the widgets
+    that read it in their last paint are repainted.
+
     @ingroup widgets
     @headerfile lui/style.hpp
 */
@@ -67,6 +121,45 @@ public:
     */
     Color find_color (int ID) const noexcept;
 
+    /** Set a metric by ID
+        @param ID The MetricID to set.
+        @param value The size to associate.
+    */
+    void set_metric (int ID, float value);
+
+    /** Find a mapped metric ID.
+        @param ID the MetricID to look for
+        @returns The size.  Will be 0 if not found
+    */
+    float find_metric (int ID) const noexcept;
+
+    /** Set a font by ID
+        @param ID The FontID to set.
+        @param font The Font to associate.
+    */
+    void set_font (int ID, const Font& font);
+
+    /** Find a mapped font ID.
+        @param ID the FontID to look for
+        @returns The Font.  Will be the default font if not found
+    */
+    Font find_font (int ID) const;
+
+    /** Returns a number bumped whenever an entry changes. */
+    uint64_t version() const noexcept { return _version; }
+
+    /** Record the entries looked up on this thread in uses, one bit per
+        entry. Returns the previous target to restore afterwards.
+        @param uses Where to record, or nullptr to stop
+        @private
+     */
+    static uint64_t* record_uses (uint64_t* uses) noexcept;
+
+    /** Record entries as looked up again, from a cached value.
+        @private
+     */
+    static void mark_uses (uint64_t uses) noexcept;
+
     // clang-format off
 
     /** Override to draw the background shape of a typical button 
@@ -91,17 +184,66 @@ public:
     // clang-format on
 
 private:
-    struct ColorItem {
-        int ID;
-        Color color;
-        bool operator== (const ColorItem& o) const noexcept { return ID == o.ID; }
-        bool operator< (const ColorItem& o) const noexcept { return ID < o.ID; }
-        bool operator> (const ColorItem& o) const noexcept { return ID > o.ID; }
-    };
-
-    std::set<ColorItem> _colors;
+    friend class detail::Main;
+    detail::StyleTable<Color> _colors;
+    detail::StyleTable<float> _metrics;
+    detail::StyleTable<Font> _fonts;
+    uint64_t _version { 0 };
+    std::function<void (uint64_t)> _changed; // with the bits of changed entries
+    void changed (uint64_t uses);
     LUI_WEAK_REFABLE (Style)
     LUI_DISABLE_COPY (Style)
 };
 
+/** A value worked out from a Style, kept until the style changes.
+
+    The entries read while resolving are remembered, so a widget painting
+    with a cached value is still repainted when one of them changes.
+
+    @code
+    lui::StyleCache<lui::Color> hover;
+    auto c = hover.get (style(), [] (const lui::Style& s) {
+        return s.find_color (lui::ColorID::BUTTON_BASE).brighter (0.1f);
+    });
+    @endcode
+
+    @ingroup widgets
+    @headerfile lui/style.hpp
+*/
+template <class T>
+class StyleCache {
+public:
+    /** Returns the cached value, resolving it first if style changed.
+        @param style The style to resolve with
+        @param resolve Called with style to work out the value
+     */
+    template <class Fn>
+    const T& get (const Style& style, Fn&& resolve) {
+        if (_style == &style && _version == style.version()) {
+            Style::mark_uses (_uses);
+            return _value;
+        }
+
+        uint64_t uses = 0;
+        auto outer    = Style::record_uses (&uses);
+        _value        = resolve (style);
+        Style::record_uses (outer);
+        Style::mark_uses (uses);
+
+        _uses    = uses;
+        _style   = &style;
+        _version = style.version();
+        return _value;
+    }
+
+    /** Resolve again on the next get(). */
+    void reset() noexcept { _style = nullptr; }
+
+private:
+    T _value {};
+    const Style* _style { nullptr };
+    uint64_t _version { 0 };
+    uint64_t _uses { 0 };
+};
+
 } // namespace lui
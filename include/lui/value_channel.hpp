@@ -0,0 +1,102 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace lui {
+
+/** Passes the latest value of something from one thread to others without
+    locks or allocation.
+
+    Meant for values produced on a realtime thread, like meter levels or
+    parameter values, and displayed by widgets. Only the latest value is
+    kept. Writing is wait-free and must only be done by one thread at a time.
+    Any thread may read. A read retries while a write is in progress, so it
+    never sees a half written value.
+
+    @code
+    auto level = std::make_shared<lui::ValueChannel<double>>();
+    meter.bind (level, 0.001);
+
+    // audio thread
+    level->write (peak);
+    @endcode
+
+    @ingroup widgets
+    @headerfile lui/value_channel.hpp
+ */
+template <typename T>
+class ValueChannel {
+public:
+    static_assert (std::is_trivially_copyable_v<T>, "value must be trivially copyable");
+
+    /** Create a channel holding an initial value. */
+    explicit ValueChannel (const T& initial = T {}) noexcept { store (initial); }
+
+    /** Publish a new value. Wait-free, single writer. */
+    void write (const T& value) noexcept {
+        const auto seq = _sequence.load (std::memory_order_relaxed);
+        _sequence.store (seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+        store (value);
+        _sequence.store (seq + 2, std::memory_order_release);
+    }
+
+    /** Returns the latest value. */
+    T read() const noexcept {
+        T value;
+        load (value);
+        return value;
+    }
+
+    /** Read the latest value if it was written since version.
+        @param value Set to the latest value when it changed
+        @param version The version last seen. Updated when it changed.
+        @returns true if there was a new value
+     */
+    bool read (T& value, uint64_t& version) const noexcept {
+        if (_sequence.load (std::memory_order_acquire) == version)
+            return false;
+        version = load (value);
+        return true;
+    }
+
+    /** Returns the current version. Changes with every write. */
+    uint64_t version() const noexcept { return _sequence.load (std::memory_order_acquire) & ~uint64_t (1); }
+
+private:
+    static constexpr size_t num_words = (sizeof (T) + sizeof (uint64_t) - 1) / sizeof (uint64_t);
+    std::atomic<uint64_t> _sequence { 0 };
+    std::atomic<uint64_t> _words[num_words] {};
+
+    void store (const T& value) noexcept {
+        uint64_t words[num_words] {};
+        std::memcpy (words, &value, sizeof (T));
+        for (size_t i = 0; i < num_words; ++i)
+            _words[i].store (words[i], std::memory_order_relaxed);
+    }
+
+    uint64_t load (T& value) const noexcept {
+        uint64_t words[num_words];
+        uint64_t seq;
+        for (;;) {
+            seq = _sequence.load (std::memory_order_acquire);
+            if ((seq & 1) != 0)
+                continue;
+            for (size_t i = 0; i < num_words; ++i)
+                words[i] = _words[i].load (std::memory_order_relaxed);
+            std::atomic_thread_fence (std::memory_order_acquire);
+            if (_sequence.load (std::memory_order_relaxed) == seq)
+                break;
+        }
+        std::memcpy (&value, words, sizeof (T));
+        return seq;
+    }
+};
+
+} // namespace lui
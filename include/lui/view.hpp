@@ -4,6 +4,7 @@
 #pragma once
 
 #include <lui/graphics.hpp>
+#include <lui/latency.hpp>
 #include <lui/lui.h>
 #include <lui/style.hpp>
 #include <lui/weak_ref.hpp>
@@ -92,6 +93,61 @@ public:
     /** Repaint a region of the view */
     void repaint (Bounds bounds);
 
+    /** True while the window is being resized interactively.
+
+        During a live resize, sizes are laid out at most once per frame.
+        Widgets can check this to paint with less detail. When resizing
+        stops, the top widget's resized() is called again and the whole
+        view repainted at full quality.
+     */
+    bool live_resizing() const noexcept;
+
+    /** Record the input this view receives to a file.
+        The recording can be played back with replay() to reproduce a user
+        session, e.g. for latency and frame time benchmarks.
+
+        @param path File to write.
+        @returns false if the file couldn't be created.
+     */
+    bool start_recording (const std::string& path);
+
+    /** Stop recording input. */
+    void stop_recording();
+
+    /** Play back a recording made with start_recording().
+
+        Playback is driven by the frame loop: events are dispatched just
+        before a frame is drawn, so each one is rendered like live input.
+        This returns straight away. A hidden view plays back on its timer.
+
+        @param path The recording to play.
+        @param realtime If true, dispatch events when their recorded time
+                        comes. Otherwise dispatch one event per frame.
+        @returns The number of events queued, or -1 if the file couldn't be read.
+     */
+    int replay (const std::string& path, bool realtime = false);
+
+    /** True while a replay() is still playing. */
+    bool replaying() const noexcept;
+
+    /** Enable or disable input latency tracking. Disabled by default.
+
+        While enabled, repaints requested while handling a key, button,
+        scroll or motion event are tagged with the time the event arrived.
+        When the backend has presented the frame showing them, swapped or
+        flushed to the window, the elapsed time is added to latency().
+     */
+    void set_latency_tracking (bool enabled);
+
+    /** Returns true if input latency is being tracked. */
+    bool latency_tracking() const noexcept;
+
+    /** Input to present latencies collected while tracking. */
+    const LatencyHistogram& latency() const noexcept;
+
+    /** Clear the collected latencies. */
+    void reset_latency();
+
     /** This is for testing. */
 #if 0
     // TODO: don't use boost
@@ -105,7 +161,9 @@ protected:
     /** Returns a pointer to the underlying PuglView. */
     uintptr_t c_obj() noexcept;
 
-    /** Subclasses should use this to render it's context */
+    /** Subclasses should use this to render it's context. The thread's
+        FrameArena is reset when it returns.
+     */
     void render (DrawingContext& surface);
 
     /** Subclasses should use this to set a PuglBackend */
@@ -120,6 +178,10 @@ protected:
     virtual void created() {}
     /** Called when the view has been destroyed */
     virtual void destroyed() {}
+    /** Override to add the memory held by the drawing context to stats */
+    virtual void add_memory_stats (MemoryStats& stats) const { lui::ignore (stats); }
+    /** Override to free cached data of the drawing context */
+    virtual void trim_caches (TrimLevel level) { lui::ignore (level); }
 
 private:
     friend class detail::View;
@@ -0,0 +1,69 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <lui/widget.hpp>
+
+namespace lui {
+namespace detail {
+class Viewport;
+} // namespace detail
+
+/** A scrollable window on to a larger content widget.
+
+    The content is added as a child and moved opposite the view position, so
+    only the parts of it inside the viewport are painted or hit-tested.
+    Scrolling over the viewport moves the view position by scroll_step()
+    pixels per line.
+
+    @ingroup widgets
+    @headerfile lui/viewport.hpp
+*/
+class LUI_API Viewport : public Widget {
+public:
+    Viewport();
+    virtual ~Viewport();
+
+    /** Set the widget to scroll. The viewport doesn't take ownership.
+        @param content The content widget or nullptr to clear it.
+     */
+    void set_content (Widget* content);
+
+    /** Returns the content widget, or nullptr. */
+    Widget* content() const noexcept;
+
+    /** Scroll so content coordinate xy is at the top left of the viewport.
+        The position is clamped to keep content in view.
+     */
+    void set_view_position (int x, int y);
+
+    /** Returns the content coordinate at the top left of the viewport. */
+    Point<int> view_position() const noexcept;
+
+    /** Returns the visible part of the content in content coordinates. */
+    Bounds view_area() const noexcept;
+
+    /** Change how many pixels one line of scrolling moves. */
+    void set_scroll_step (int pixels);
+
+    /** Returns how many pixels one line of scrolling moves. */
+    int scroll_step() const noexcept;
+
+protected:
+    /** @private */
+    bool obstructed (int, int) override { return true; }
+    /** @private */
+    bool scroll (const ScrollEvent& ev) override;
+    /** @private */
+    void resized() override;
+    /** @private */
+    void child_size_changed (Widget* child) override;
+
+private:
+    friend class detail::Viewport;
+    std::unique_ptr<detail::Viewport> impl;
+    LUI_DISABLE_COPY (Viewport)
+};
+
+} // namespace lui
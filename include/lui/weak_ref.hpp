@@ -20,14 +20,14 @@ public:
 
     WeakStatus() : status (std::make_shared<Status>()) {}
     WeakStatus (const WeakStatus& o) { status = o.status; }
-    WeakStatus (WeakStatus&& o) { status = std::move (o.status); }
+    WeakStatus (WeakStatus&& o) noexcept { status = std::move (o.status); }
     ~WeakStatus() { status.reset(); }
 
     WeakStatus& operator= (const WeakStatus& o) {
         status = o.status;
         return *this;
     }
-    WeakStatus& operator= (WeakStatus&& o) {
+    WeakStatus& operator= (WeakStatus&& o) noexcept {
         status = std::move (o.status);
         return *this;
     }
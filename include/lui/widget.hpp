@@ -9,11 +9,14 @@
 
 #pragma once
 
+#include <cassert>
+#include <span>
 #include <vector>
 
 #include <lui/graphics.hpp>
 #include <lui/input.hpp>
 #include <lui/lui.h>
+#include <lui/slot_map.hpp>
 #include <lui/view.hpp>
 #include <lui/weak_ref.hpp>
 
@@ -21,8 +24,71 @@ namespace lui {
 namespace detail {
 /** @private */
 class Widget;
+/** @private */
+class RenderList;
 } // namespace detail
 
+class Widget;
+
+/** A handle to a Widget that knows when it has been deleted.
+
+    Works like WidgetRef but holds a slot index and generation instead of a
+    shared status block, so copies are plain integer copies and checks have
+    no atomic reference counting. Handles belong to the thread that made
+    the widget: every thread has its own table, and looking one up on
+    another thread asserts and finds nothing.
+
+    @ingroup widgets
+    @headerfile lui/widget.hpp
+    @see Widget::handle, WidgetRef
+*/
+class LUI_API WidgetHandle {
+public:
+    WidgetHandle() = default;
+    WidgetHandle (Widget* widget) noexcept;
+
+    /** Returns the widget if not deleted, otherwise nullptr. Also nullptr
+        on a thread other than the one that made the handle.
+     */
+    Widget* lock() const noexcept {
+        auto& table = widgets();
+        assert (_table == nullptr || _table == &table);
+        if (_table != nullptr && _table != &table)
+            return nullptr;
+        auto widget = table.find (_key);
+        return widget != nullptr ? *widget : nullptr;
+    }
+
+    /** Same as lock(). */
+    Widget* get() const noexcept { return lock(); }
+
+    /** Cast the widget to specified type. */
+    template <class T>
+    T* as() const noexcept {
+        return dynamic_cast<T*> (lock());
+    }
+
+    /** Returns true if the widget hasn't been deleted */
+    bool valid() const noexcept { return lock() != nullptr; }
+
+    /** Returns the slot key of this handle. */
+    SlotKey key() const noexcept { return _key; }
+
+    Widget* operator->() const noexcept { return lock(); }
+
+    bool operator== (const WidgetHandle& o) const noexcept { return lock() == o.lock(); }
+    bool operator== (const Widget* o) const noexcept { return lock() == o; }
+    bool operator== (std::nullptr_t) const noexcept { return lock() == nullptr; }
+    explicit operator bool() const noexcept { return lock() != nullptr; }
+
+private:
+    friend class Widget;
+    /** Returns the table of the calling thread. */
+    static SlotMap<Widget*>& widgets() noexcept;
+    SlotKey _key;
+    const SlotMap<Widget*>* _table { nullptr };
+};
+
 /** Base class for all Widgets and Windows.
     @ingroup widgets
     @headerfile lui/widget.hpp
@@ -62,6 +128,44 @@ public:
      */
     void remove (Widget& widget);
 
+    /** Add child widgets, sending notifications and repaints once.
+        @param widgets The widgets to add, back to front
+     */
+    void add_all (std::span<Widget* const> widgets);
+
+    /** Remove child widgets, sending notifications and repaints once.
+        @param widgets The widgets to remove
+     */
+    void remove_all (std::span<Widget* const> widgets);
+
+    /** Remove every child widget, sending notifications and repaints once. */
+    void remove_all();
+
+    /** Returns the number of child widgets. */
+    size_t num_children() const noexcept;
+
+    /** Returns a child widget in paint order, back to front.
+        @param index Position of the child, 0 is the back
+     */
+    Widget* child_at (size_t index) const noexcept;
+
+    /** Set the stacking order among siblings.
+        Children are painted from the lowest z order to the highest and the
+        highest gets input first. Siblings with equal z order stack in the
+        order they were added or raised. The default is 0.
+        @param z The z order
+     */
+    void set_z_order (int z);
+
+    /** Returns the z order set with set_z_order(). */
+    int z_order() const noexcept;
+
+    /** Raise above the siblings with the same z order. */
+    void to_front();
+
+    /** Lower below the siblings with the same z order. */
+    void to_back();
+
     /** Returns true if this widget is visible. */
     bool visible() const noexcept;
 
@@ -76,6 +180,11 @@ public:
     /** Request this widget be repainted. */
     void repaint();
 
+    /** Request a region of this widget be repainted.
+        @param area The region to repaint in local coordinates.
+     */
+    void repaint (Bounds area);
+
     /** Returns true if this widget reports being opaque. */
     bool opaque() const noexcept;
 
@@ -152,7 +261,8 @@ public:
     Point<float> to_view_space (Point<float> coord);
 
     /** Called by the View to render this Widget.
-        Invokes Widget::paint on this and all children recursively
+        Invokes Widget::paint on this and all children recursively.
+        Widgets entirely behind opaque widgets are not painted.
      */
     void render (Graphics& g);
 
@@ -189,12 +299,54 @@ public:
      */
     uintptr_t find_handle() const noexcept;
 
+    /** Returns a handle to this widget.
+        @see WidgetHandle
+     */
+    WidgetHandle handle() const noexcept { return WidgetHandle (const_cast<Widget*> (this)); }
+
     /** Returns the current style used by this widget
         @returns Style The style used
      */
     Style& style();
 
+    /** Defers change notifications and repaints while in scope.
+
+        Widgets changed while a batch is open get their new bounds,
+        visibility and children right away, but moved(), resized(),
+        children_changed(), parent_structure_changed() and the like are
+        queued and sent once per widget when the batch ends, along with one
+        merged repaint per view. Changes made by those notifications are
+        batched too. Batches may nest; the outermost one dispatches.
+
+        Use it when building or rearranging many widgets at once.
+        Widgets are UI thread objects, so a batch only covers the thread
+        that opened it.
+
+        @code
+        {
+            lui::Widget::UpdateBatch batch;
+            for (auto& row : rows)
+                page.add (*row);
+        } // notified and repainted here
+        @endcode
+     */
+    class LUI_API UpdateBatch {
+    public:
+        UpdateBatch();
+        ~UpdateBatch();
+
+        /** End this batch now instead of at the end of scope. */
+        void commit();
+
+    private:
+        bool _open { true };
+        LUI_DISABLE_COPY (UpdateBatch)
+    };
+
 protected:
+    /** Set true if paint() fills every pixel of the bounds. Widgets
+        behind opaque ones are skipped when rendering.
+     */
     void set_opaque (bool opaque);
 
     virtual void resized() {}
@@ -208,6 +360,11 @@ protected:
     virtual void enter (const Event&) {}
     virtual void exit (const Event&) {}
 
+    /** Called when scrolled over. Return true if handled, otherwise the
+        event is passed on to the parent.
+     */
+    virtual bool scroll (const ScrollEvent&) { return false; }
+
     virtual bool key_down (const KeyEvent&) { return false; }
     virtual bool key_up (const KeyEvent&) { return false; }
     virtual bool text_entry (const TextEvent&) { return false; }
@@ -216,6 +373,7 @@ protected:
     virtual void parent_structure_changed() {}
     virtual void parent_size_changed() {}
     virtual void child_size_changed (Widget* child) { lui::ignore (child); }
+    virtual void child_visibility_changed (Widget* child) { lui::ignore (child); }
 
 private:
     friend class detail::Widget;
@@ -223,15 +381,26 @@ private:
     friend class detail::Main;
     friend class View;
     friend class detail::View;
+    friend class detail::RenderList;
+    friend class WidgetHandle;
 
     void add_internal (Widget*);
 
     std::unique_ptr<detail::Widget> impl;
+    SlotKey _handle;
     LUI_WEAK_REFABLE (Widget)
 };
 
 /** A Weak Reference to a Widget. */
 using WidgetRef = WeakRef<Widget>;
+
+inline WidgetHandle::WidgetHandle (Widget* widget) noexcept {
+    if (widget == nullptr)
+        return;
+    _key   = widget->_handle;
+    _table = &widgets();
+    assert (_table->find (_key) != nullptr && *_table->find (_key) == widget);
+}
 } // namespace lui
 
 /** @} */
@@ -0,0 +1,286 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <lui/animator.hpp>
+#include <lui/main.hpp>
+
+#include "detail/frame.hpp"
+#include "detail/main.hpp"
+
+namespace lui {
+namespace detail {
+
+class Animator : public std::enable_shared_from_this<Animator> {
+public:
+    using ID = lui::Animator::ID;
+
+    enum Kind : uint8_t {
+        TWEEN = 0,
+        SPRING,
+        BOUNDS
+    };
+
+    struct Animation {
+        ID id { 0 };
+        Kind kind { TWEEN };
+        bool done { false };
+        bool has_widget { false };
+        WidgetRef widget;
+        lui::Animator::Setter setter;
+        std::function<void()> finished;
+
+        double start { -1.0 };
+        double last { -1.0 };
+        double from { 0.0 };
+        double to { 0.0 };
+        double value { 0.0 };
+        double velocity { 0.0 };
+        double duration { 0.0 };
+        Easing curve { easing::linear };
+        Spring spring;
+        Bounds from_bounds;
+        Bounds to_bounds;
+    };
+
+    explicit Animator (lui::Main* m) : main (m) {}
+
+    ID add (std::unique_ptr<Animation> anim, lui::Widget* widget) {
+        anim->id         = ++last_id;
+        anim->value      = anim->from;
+        anim->has_widget = widget != nullptr;
+        anim->widget     = widget;
+        animations.push_back (std::move (anim));
+        start_ticking();
+        return last_id;
+    }
+
+    Animation* find (ID id) const noexcept {
+        for (const auto& anim : animations)
+            if (anim->id == id && ! anim->done)
+                return anim.get();
+        return nullptr;
+    }
+
+    void cancel (lui::Widget& widget, bool bounds_only) {
+        for (auto& anim : animations)
+            if (anim->has_widget && anim->widget.get() == &widget)
+                if (! bounds_only || anim->kind == BOUNDS)
+                    anim->done = true;
+    }
+
+    size_t size() const noexcept {
+        return std::count_if (animations.begin(), animations.end(), [] (const auto& anim) {
+            return ! anim->done;
+        });
+    }
+
+    void tick (double now) {
+        if (animations.empty())
+            return;
+
+        if (main != nullptr)
+            main->impl->begin_repaints();
+
+        std::vector<std::function<void()>> finished;
+        // animations added by setters start next frame.
+        const auto count = animations.size();
+        for (size_t i = 0; i < count; ++i) {
+            auto anim = animations[i].get();
+            if (anim->done)
+                continue;
+            if (anim->has_widget && ! anim->widget.valid()) {
+                anim->done = true;
+                continue;
+            }
+
+            if (anim->start < 0.0) {
+                anim->start = anim->last = now;
+                if (anim->kind == BOUNDS)
+                    anim->from_bounds = anim->widget->bounds();
+            }
+
+            if (advance (*anim, now)) {
+                anim->done = true;
+                if (anim->finished)
+                    finished.push_back (std::move (anim->finished));
+            }
+        }
+
+        animations.erase (std::remove_if (animations.begin(), animations.end(), [] (const auto& anim) {
+                              return anim->done;
+                          }),
+                          animations.end());
+
+        if (main != nullptr)
+            main->impl->end_repaints();
+
+        for (auto& callback : finished)
+            callback();
+    }
+
+private:
+    lui::Main* main { nullptr };
+    std::vector<std::unique_ptr<Animation>> animations;
+    ID last_id { 0 };
+    bool ticking { false };
+
+    /** Register with the frame tasks of this thread, until idle. */
+    void start_ticking() {
+        if (main == nullptr || ticking)
+            return;
+        ticking                    = true;
+        std::weak_ptr<Animator> wp = shared_from_this();
+        FrameTasks::current().add ([wp] (double now) {
+            auto self = wp.lock();
+            if (self == nullptr)
+                return false;
+            self->tick (now);
+            self->ticking = ! self->animations.empty();
+            return self->ticking;
+        });
+    }
+
+    /** Move an animation to now. Returns true when finished. */
+    static bool advance (Animation& anim, double now) {
+        if (anim.kind == SPRING)
+            return advance_spring (anim, now);
+
+        const auto t = anim.duration > 0.0 ? std::clamp ((now - anim.start) / anim.duration, 0.0, 1.0) : 1.0;
+        const auto p = t < 1.0 ? anim.curve (t) : 1.0;
+
+        if (anim.kind == BOUNDS) {
+            const auto& a = anim.from_bounds;
+            const auto& b = anim.to_bounds;
+            anim.widget->set_bounds (lerp (a.x, b.x, p), lerp (a.y, b.y, p), lerp (a.width, b.width, p), lerp (a.height, b.height, p));
+        } else {
+            anim.value = anim.from + (anim.to - anim.from) * p;
+            anim.setter (anim.value);
+        }
+
+        return t >= 1.0;
+    }
+
+    static bool advance_spring (Animation& anim, double now) {
+        // fixed sub-steps keep stiff springs stable at any frame rate.
+        static constexpr double step = 1.0 / 240.0;
+        const auto& s                = anim.spring;
+        const auto mass              = std::max (s.mass, 1.0e-6);
+        auto elapsed                 = std::min (now - anim.last, 0.25);
+        anim.last                    = now;
+
+        while (elapsed > 0.0) {
+            const auto dt    = std::min (step, elapsed);
+            const auto force = -s.stiffness * (anim.value - anim.to) - s.damping * anim.velocity;
+            anim.velocity += force / mass * dt;
+            anim.value += anim.velocity * dt;
+            elapsed -= dt;
+        }
+
+        const bool settled = std::abs (anim.value - anim.to) < s.precision
+                             && std::abs (anim.velocity) < s.precision;
+        if (settled) {
+            anim.value    = anim.to;
+            anim.velocity = 0.0;
+        }
+
+        anim.setter (anim.value);
+        return settled;
+    }
+
+    static int lerp (int a, int b, double p) noexcept {
+        return static_cast<int> (std::lround (a + (b - a) * p));
+    }
+};
+
+} // namespace detail
+
+Animator::Animator() : impl (std::make_shared<detail::Animator> (nullptr)) {}
+Animator::Animator (Main& main) : impl (std::make_shared<detail::Animator> (&main)) {}
+Animator::~Animator() { impl.reset(); }
+
+Animator::ID Animator::tween (double from, double to, double seconds, Setter setter, Easing curve) {
+    auto anim      = std::make_unique<detail::Animator::Animation>();
+    anim->from     = from;
+    anim->to       = to;
+    anim->duration = seconds;
+    anim->setter   = std::move (setter);
+    anim->curve    = curve != nullptr ? curve : easing::linear;
+    return anim->setter ? impl->add (std::move (anim), nullptr) : 0;
+}
+
+Animator::ID Animator::tween (Widget& widget, double from, double to, double seconds, Setter setter, Easing curve) {
+    auto id = tween (from, to, seconds, std::move (setter), curve);
+    if (auto anim = impl->find (id)) {
+        anim->has_widget = true;
+        anim->widget     = &widget;
+    }
+    return id;
+}
+
+Animator::ID Animator::tween_bounds (Widget& widget, Bounds target, double seconds, Easing curve) {
+    impl->cancel (widget, true);
+    auto anim       = std::make_unique<detail::Animator::Animation>();
+    anim->kind      = detail::Animator::BOUNDS;
+    anim->to_bounds = target;
+    anim->duration  = seconds;
+    anim->curve     = curve != nullptr ? curve : easing::linear;
+    return impl->add (std::move (anim), &widget);
+}
+
+Animator::ID Animator::spring (double from, double to, Setter setter, Spring params) {
+    auto anim    = std::make_unique<detail::Animator::Animation>();
+    anim->kind   = detail::Animator::SPRING;
+    anim->from   = from;
+    anim->to     = to;
+    anim->setter = std::move (setter);
+    anim->spring = params;
+    return anim->setter ? impl->add (std::move (anim), nullptr) : 0;
+}
+
+Animator::ID Animator::spring (Widget& widget, double from, double to, Setter setter, Spring params) {
+    auto id = spring (from, to, std::move (setter), params);
+    if (auto anim = impl->find (id)) {
+        anim->has_widget = true;
+        anim->widget     = &widget;
+    }
+    return id;
+}
+
+bool Animator::retarget (ID id, double to) {
+    auto anim = impl->find (id);
+    if (anim == nullptr || anim->kind == detail::Animator::BOUNDS)
+        return false;
+    if (anim->kind == detail::Animator::TWEEN) {
+        anim->from  = anim->value;
+        anim->start = -1.0;
+    }
+    anim->to = to;
+    return true;
+}
+
+bool Animator::on_finished (ID id, std::function<void()> callback) {
+    auto anim = impl->find (id);
+    if (anim == nullptr)
+        return false;
+    anim->finished = std::move (callback);
+    return true;
+}
+
+bool Animator::cancel (ID id) {
+    auto anim = impl->find (id);
+    if (anim == nullptr)
+        return false;
+    anim->done = true;
+    return true;
+}
+
+void Animator::cancel (Widget& widget) { impl->cancel (widget, false); }
+bool Animator::running (ID id) const noexcept { return impl->find (id) != nullptr; }
+size_t Animator::size() const noexcept { return impl->size(); }
+void Animator::tick (double now) { impl->tick (now); }
+
+} // namespace lui
@@ -0,0 +1,66 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#include <lui/arena.hpp>
+
+namespace lui {
+
+FrameArena::FrameArena (size_t chunk_size)
+    : _chunk_size (std::max (chunk_size, size_t (256))) {}
+
+FrameArena::~FrameArena() { release(); }
+
+FrameArena& FrameArena::current() noexcept {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+void FrameArena::reset() noexcept {
+    _chunk             = 0;
+    _offset            = 0;
+    _stats.allocations = 0;
+    _stats.bytes       = 0;
+}
+
+void FrameArena::release() noexcept {
+    for (auto& chunk : _chunks)
+        ::operator delete (chunk.data);
+    _chunks.clear();
+    _stats.capacity = 0;
+    reset();
+}
+
+void* FrameArena::do_allocate (size_t bytes, size_t alignment) {
+    ++_stats.allocations;
+    _stats.bytes += bytes;
+
+    for (; _chunk < _chunks.size(); ++_chunk, _offset = 0) {
+        auto& chunk      = _chunks[_chunk];
+        const auto start = reinterpret_cast<uintptr_t> (chunk.data) + _offset;
+        const auto pad   = (alignment - start % alignment) % alignment;
+        if (_offset + pad + bytes <= chunk.size) {
+            _offset += pad + bytes;
+            return chunk.data + (_offset - bytes);
+        }
+    }
+
+    // chunks come from operator new, aligned for anything up to
+    // max_align_t; oversized alignments pad inside the chunk.
+    const auto size = std::max (_chunk_size, bytes + alignment);
+    _chunks.push_back ({ static_cast<std::byte*> (::operator new (size)), size });
+    ++_stats.heap_allocations;
+    _stats.capacity += size;
+
+    auto& chunk      = _chunks.back();
+    _chunk           = _chunks.size() - 1;
+    const auto start = reinterpret_cast<uintptr_t> (chunk.data);
+    const auto pad   = (alignment - start % alignment) % alignment;
+    _offset          = pad + bytes;
+    return chunk.data + pad;
+}
+
+} // namespace lui
@@ -3,6 +3,8 @@
 
 #include <lui/button.hpp>
 
+#include "detail/pool.hpp"
+
 namespace lui {
 namespace detail {
 
@@ -10,6 +12,8 @@ class Button {
 public:
     Button (lui::Button& b) : owner (b) {}
 
+    LUI_POOL_ALLOCATED
+
 private:
     lui::Button& owner;
     friend class lui::Button;
@@ -26,6 +30,8 @@ class TextButton {
 public:
     TextButton (lui::TextButton& o) : owner (o) {}
 
+    LUI_POOL_ALLOCATED
+
 private:
     lui::TextButton& owner;
     friend class lui::TextButton;
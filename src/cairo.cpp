@@ -3,6 +3,9 @@
 
 #include <cassert>
 #include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #if _MSC_VER
 #    ifndef NOMINMAX
@@ -24,6 +27,89 @@
 namespace lui {
 namespace cairo {
 
+/** Caches glyph runs per (scaled font, text).
+
+    Converting UTF-8 to glyphs and measuring them is the expensive part of
+    cairo's toy text API. Labels and readouts redraw the same strings every
+    frame, so keep the converted run and its extents around. Glyph positions
+    are stored relative to the origin and offset at draw time.
+ */
+class GlyphRunCache {
+public:
+    struct Run {
+        std::vector<cairo_glyph_t> glyphs;
+        cairo_text_extents_t extents;
+    };
+
+    GlyphRunCache() = default;
+    ~GlyphRunCache() { clear(); }
+
+    /** Returns the cached run for text in font, building it on a miss.
+        Returns nullptr if cairo could not convert the text.
+     */
+    const Run* find (cairo_scaled_font_t* font, std::string_view text) {
+        if (font == nullptr || cairo_scaled_font_status (font) != CAIRO_STATUS_SUCCESS)
+            return nullptr;
+
+        key.font = font;
+        key.text.assign (text.data(), text.size());
+        if (auto it = runs.find (key); it != runs.end())
+            return &it->second;
+
+        cairo_glyph_t* glyphs = nullptr;
+        int num_glyphs        = 0;
+        if (cairo_scaled_font_text_to_glyphs (font, 0.0, 0.0, text.data(), static_cast<int> (text.size()), &glyphs, &num_glyphs, nullptr, nullptr, nullptr)
+            != CAIRO_STATUS_SUCCESS) {
+            return nullptr;
+        }
+
+        if (runs.size() >= max_runs)
+            clear();
+
+        Run run;
+        run.glyphs.assign (glyphs, glyphs + num_glyphs);
+        cairo_glyph_free (glyphs);
+        cairo_scaled_font_glyph_extents (font, run.glyphs.data(), num_glyphs, &run.extents);
+
+        // Hold a reference so the pointer in the key can't be recycled.
+        cairo_scaled_font_reference (font);
+        return &runs.emplace (key, std::move (run)).first->second;
+    }
+
+    /** Returns an estimate of the bytes held by cached runs. */
+    size_t memory_size() const noexcept {
+        size_t bytes = runs.bucket_count() * sizeof (void*);
+        for (const auto& r : runs)
+            bytes += sizeof (r) + r.first.text.capacity() + r.second.glyphs.capacity() * sizeof (cairo_glyph_t);
+        return bytes;
+    }
+
+    /** Drop all cached runs. */
+    void clear() {
+        for (auto& r : runs)
+            cairo_scaled_font_destroy (r.first.font);
+        runs.clear();
+    }
+
+private:
+    struct Key {
+        cairo_scaled_font_t* font { nullptr };
+        std::string text;
+
+        bool operator== (const Key& o) const noexcept { return font == o.font && text == o.text; }
+    };
+
+    struct KeyHash {
+        size_t operator() (const Key& k) const noexcept {
+            return std::hash<std::string>() (k.text) ^ (std::hash<void*>() (k.font) << 1);
+        }
+    };
+
+    static constexpr size_t max_runs = 512;
+    std::unordered_map<Key, Run, KeyHash> runs;
+    Key key; // lookup scratch, keeps its string capacity between calls
+};
+
 class Context : public DrawingContext {
 public:
     explicit Context (cairo_t* context = nullptr)
@@ -208,8 +294,9 @@ public:
     }
 
     TextMetrics text_metrics (std::string_view text) const noexcept override {
-        cairo_text_extents_t cte;
-        cairo_text_extents (cr, text.data(), &cte);
+        cairo_text_extents_t cte {};
+        if (auto run = glyph_runs.find (cairo_get_scaled_font (cr), text))
+            cte = run->extents;
         return {
             cte.width,
             cte.height,
@@ -220,9 +307,61 @@ public:
         };
     }
 
+    void text_positions (std::string_view text, std::vector<float>& xs) const override {
+        xs.clear();
+        auto font                       = cairo_get_scaled_font (cr);
+        cairo_glyph_t* glyphs           = nullptr;
+        cairo_text_cluster_t* clusters  = nullptr;
+        int num_glyphs                  = 0;
+        int num_clusters                = 0;
+        cairo_text_cluster_flags_t flags {};
+
+        if (text.empty() || cairo_scaled_font_text_to_glyphs (font, 0.0, 0.0, text.data(), static_cast<int> (text.size()), &glyphs, &num_glyphs, &clusters, &num_clusters, &flags) != CAIRO_STATUS_SUCCESS) {
+            DrawingContext::text_positions (text, xs);
+            return;
+        }
+
+        // every code point of a cluster starts where its first glyph does.
+        size_t byte = 0;
+        int glyph   = 0;
+        for (int c = 0; c < num_clusters; ++c) {
+            const auto& cl = clusters[c];
+            const auto x   = glyph < num_glyphs ? static_cast<float> (glyphs[glyph].x) : (xs.empty() ? 0.f : xs.back());
+            for (int b = 0; b < cl.num_bytes; ++b)
+                if ((static_cast<uint8_t> (text[byte + (size_t) b]) & 0xC0) != 0x80)
+                    xs.push_back (x);
+            byte += (size_t) cl.num_bytes;
+            glyph += cl.num_glyphs;
+        }
+
+        cairo_text_extents_t extents {};
+        cairo_scaled_font_glyph_extents (font, glyphs, num_glyphs, &extents);
+        xs.push_back (static_cast<float> (extents.x_advance));
+        cairo_glyph_free (glyphs);
+        cairo_text_cluster_free (clusters);
+    }
+
     bool show_text (std::string_view text) override {
+        auto run = glyph_runs.find (cairo_get_scaled_font (cr), text);
+        if (run == nullptr)
+            return false;
+
         apply_pending_state();
-        cairo_show_text (cr, text.data());
+
+        double x = 0.0, y = 0.0;
+        if (cairo_has_current_point (cr))
+            cairo_get_current_point (cr, &x, &y);
+
+        placed.resize (run->glyphs.size());
+        for (size_t i = 0; i < placed.size(); ++i) {
+            placed[i]   = run->glyphs[i];
+            placed[i].x += x;
+            placed[i].y += y;
+        }
+
+        cairo_show_glyphs (cr, placed.data(), static_cast<int> (placed.size()));
+        // match cairo_show_text, which leaves the point after the text.
+        cairo_move_to (cr, x + run->extents.x_advance, y + run->extents.y_advance);
         return true;
     }
 
@@ -263,6 +402,20 @@ public:
         cairo_surface_destroy (image);
     }
 
+    void add_memory_stats (MemoryStats& stats) const override {
+        stats.path_cache += glyph_runs.memory_size() + placed.capacity() * sizeof (cairo_glyph_t);
+        stats.context_stacks += stack.capacity() * sizeof (State);
+    }
+
+    void trim_caches (TrimLevel level) override {
+        stack.clear();
+        stack.shrink_to_fit();
+        placed.clear();
+        placed.shrink_to_fit();
+        if (level >= TrimLevel::CACHES)
+            glyph_runs.clear();
+    }
+
 private:
     cairo_t* cr { nullptr };
     struct State {
@@ -281,6 +434,9 @@ private:
     State state;
     std::vector<State> stack;
 
+    mutable GlyphRunCache glyph_runs;
+    std::vector<cairo_glyph_t> placed;
+
     bool _fill_dirty = false;
 
     void apply_pending_state() {
@@ -346,6 +502,16 @@ public:
         cairo_restore (cr);
     }
 
+    void add_memory_stats (MemoryStats& stats) const override {
+        if (_context)
+            _context->add_memory_stats (stats);
+    }
+
+    void trim_caches (TrimLevel level) override {
+        if (_context)
+            _context->trim_caches (level);
+    }
+
     void created() override {
         _context = std::make_unique<Context>();
         _view    = (PuglView*) c_obj();
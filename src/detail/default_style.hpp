@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
+
+#include <lui/button.hpp>
 #include <lui/graphics.hpp>
 #include <lui/slider.hpp>
 #include <lui/style.hpp>
@@ -27,6 +30,15 @@ public:
         set_color (ColorID::SLIDER_THUMB, fg.darker (0.52f));
 
         set_color (ColorID::VIEW_BACKGROUND, Color (0xff000000));
+
+        set_metric (MetricID::CORNER_SIZE, 4.f);
+        set_metric (MetricID::LINE_WIDTH, 1.2f);
+        set_metric (MetricID::SLIDER_TRACK_SIZE, 4.f);
+        set_metric (MetricID::SLIDER_THUMB_SIZE, 16.f);
+        set_metric (MetricID::SLIDER_THUMB_CORNER, 6.f);
+
+        set_font (FontID::DEFAULT, lui::Font (15.f));
+        set_font (FontID::BUTTON, lui::Font (13.f));
     }
 
     ~DefaultStyle() {}
@@ -40,9 +52,9 @@ public:
                 bc = bc.brighter (-0.035f);
         }
 
-        auto line_width = 1.2;
+        auto line_width = find_metric (MetricID::LINE_WIDTH);
         auto r          = w.bounds().at (0).reduced (1);
-        auto cs         = 4.f;
+        auto cs         = find_metric (MetricID::CORNER_SIZE);
 
         g.set_color (bc);
         g.fill_rounded_rect (r, cs);
@@ -63,7 +75,8 @@ public:
         }
 
         g.set_color (c);
-        g.set_font (std::min (13.f, w.height() * 0.55f));
+        const auto font = find_font (FontID::BUTTON);
+        g.set_font (font.with_height (std::min (font.height(), w.height() * 0.55f)));
         auto r = w.bounds().at (0).as<float>();
         g.draw_text (w.text(), r, Justify::CENTERED);
     }
@@ -102,7 +115,7 @@ public:
     void draw_slider_background (Graphics& g, lui::Slider& slider, Bounds bounds, float pos) override {
         (void) pos;
 
-        int track_size = 4;
+        auto track_size = (int) find_metric (MetricID::SLIDER_TRACK_SIZE);
 
         if (slider.vertical()) {
             bounds.reduce ((slider.width() - track_size) / 2, 0);
@@ -115,8 +128,8 @@ public:
     }
 
     void draw_slider_thumb (Graphics& g, lui::Slider& slider, Bounds bounds, float pos) override {
-        float thumb_size  = 16.f;
-        float corner_size = 6.f;
+        float thumb_size  = find_metric (MetricID::SLIDER_THUMB_SIZE);
+        float corner_size = find_metric (MetricID::SLIDER_THUMB_CORNER);
         float x = 0.f, y = 0.f;
 
         Range<float> pixel_range (0.f, (float) (slider.vertical() ? bounds.height : bounds.width));
@@ -0,0 +1,66 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace lui {
+namespace detail {
+
+/** Work done once per frame on a UI thread.
+
+    Every view ticks the tasks of its thread from its timer. Ticks closer
+    together than min_interval are skipped, so tasks run once per frame no
+    matter how many views are open. A task returning false is removed.
+ */
+class FrameTasks {
+public:
+    using Task = std::function<bool (double now)>;
+
+    /** Ticks closer together than this, in seconds, are skipped. */
+    static constexpr double min_interval = 0.008;
+
+    /** Returns the tasks of the calling thread. */
+    static FrameTasks& current() noexcept {
+        thread_local FrameTasks tasks;
+        return tasks;
+    }
+
+    /** Add a task to run on every frame. It is passed the time in seconds. */
+    void add (Task task) { tasks.push_back (std::move (task)); }
+
+    /** Number of tasks. */
+    size_t size() const noexcept { return tasks.size(); }
+
+    /** Run all tasks, unless the last tick was less than min_interval ago.
+        @param now Current time in seconds
+        @returns true if tasks were run
+     */
+    bool tick (double now) {
+        if (last >= 0.0 && now >= last && now - last < min_interval)
+            return false;
+        last = now;
+
+        // tasks added while running wait for the next frame.
+        const auto count = tasks.size();
+        size_t keep      = 0;
+        for (size_t i = 0; i < count; ++i) {
+            auto task = std::move (tasks[i]);
+            if (task (now))
+                tasks[keep++] = std::move (task);
+        }
+        for (size_t i = count; i < tasks.size(); ++i)
+            tasks[keep++] = std::move (tasks[i]);
+        tasks.resize (keep);
+        return true;
+    }
+
+private:
+    std::vector<Task> tasks;
+    double last { -1.0 };
+};
+
+} // namespace detail
+} // namespace lui
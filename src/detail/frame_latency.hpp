@@ -0,0 +1,79 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <algorithm>
+
+#include <lui/latency.hpp>
+
+namespace lui {
+namespace detail {
+
+/** Input to present latency of one view.
+
+    While input is handled, repaints it requests tag the next frame with
+    when that input arrived. Once that frame is drawn the tag waits for
+    presented(), which the view calls after the backend has swapped or
+    flushed the frame, and only then is a sample added. Times are in
+    seconds on any one clock.
+ */
+class FrameLatency {
+public:
+    /** True if samples are being taken. */
+    bool enabled() const noexcept { return _enabled; }
+
+    /** Start or stop taking samples. Pending input is forgotten. */
+    void set_enabled (bool enabled) noexcept {
+        _enabled    = enabled;
+        _input      = -1.0;
+        _waiting    = -1.0;
+        _presenting = -1.0;
+    }
+
+    /** Arrival of the input being handled, or less than zero if none. */
+    double input() const noexcept { return _input; }
+
+    /** Set when the input being handled arrived, or -1 when done with it. */
+    void set_input (double time) noexcept { _input = time; }
+
+    /** A repaint was requested. Tags the next frame if handling input. */
+    void repaint_requested() noexcept {
+        if (_input < 0.0)
+            return;
+        if (_waiting < 0.0 || _input < _waiting)
+            _waiting = _input;
+    }
+
+    /** A frame was drawn. Input it shows waits for it to be presented. */
+    void exposed() noexcept {
+        if (_waiting < 0.0)
+            return;
+        _presenting = _presenting < 0.0 ? _waiting : std::min (_presenting, _waiting);
+        _waiting    = -1.0;
+    }
+
+    /** The last frame drawn was presented at time. */
+    void presented (double time) noexcept {
+        if (_presenting < 0.0)
+            return;
+        _histogram.add (time - _presenting);
+        _presenting = -1.0;
+    }
+
+    /** The samples taken so far. */
+    const LatencyHistogram& histogram() const noexcept { return _histogram; }
+
+    /** Remove all samples. */
+    void clear() noexcept { _histogram.clear(); }
+
+private:
+    bool _enabled { false };
+    double _input { -1.0 };      // arrival of the input being handled
+    double _waiting { -1.0 };    // earliest input waiting for a frame
+    double _presenting { -1.0 }; // earliest input drawn, not yet presented
+    LatencyHistogram _histogram;
+};
+
+} // namespace detail
+} // namespace lui
@@ -0,0 +1,130 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <lui/string.hpp>
+
+namespace lui {
+namespace detail {
+
+/** A gap buffer of bytes.
+
+    Keeps a movable hole at the last edit position so consecutive inserts and
+    deletes near the caret are O(1) amortized. Positions are byte offsets into
+    the logical text; the buffer itself knows nothing about UTF-8.
+ */
+class GapBuffer {
+public:
+    GapBuffer() = default;
+
+    /** Number of bytes of logical text. */
+    size_t size() const noexcept { return _data.size() - gap_size(); }
+
+    /** True if there is no text. */
+    bool empty() const noexcept { return size() == 0; }
+
+    /** Returns the byte at logical position pos. */
+    char operator[] (size_t pos) const noexcept {
+        return pos < _gap_start ? _data[pos] : _data[pos + gap_size()];
+    }
+
+    /** Insert bytes at logical position pos. */
+    void insert (size_t pos, std::string_view bytes) {
+        if (bytes.empty())
+            return;
+        pos = std::min (pos, size());
+        if (gap_size() < bytes.size())
+            grow (bytes.size());
+        move_gap (pos);
+        std::memcpy (_data.data() + _gap_start, bytes.data(), bytes.size());
+        _gap_start += bytes.size();
+    }
+
+    /** Erase count bytes starting at logical position pos. */
+    void erase (size_t pos, size_t count) {
+        if (pos >= size())
+            return;
+        count = std::min (count, size() - pos);
+        move_gap (pos);
+        _gap_end += count;
+    }
+
+    /** Remove all text. Capacity is kept. */
+    void clear() noexcept {
+        _gap_start = 0;
+        _gap_end   = _data.size();
+    }
+
+    /** Copy count bytes starting at pos in to dst. */
+    void copy (size_t pos, size_t count, char* dst) const noexcept {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = operator[] (pos + i);
+    }
+
+    /** Returns the logical text as a contiguous String. */
+    lui::String text() const {
+        std::string out;
+        out.reserve (size());
+        out.append (_data.data(), _gap_start);
+        out.append (_data.data() + _gap_end, _data.size() - _gap_end);
+        return lui::String (std::move (out));
+    }
+
+private:
+    std::vector<char> _data;
+    size_t _gap_start = 0;
+    size_t _gap_end   = 0;
+
+    size_t gap_size() const noexcept { return _gap_end - _gap_start; }
+
+    void move_gap (size_t pos) {
+        if (pos < _gap_start) {
+            const auto n = _gap_start - pos;
+            std::memmove (_data.data() + _gap_end - n, _data.data() + pos, n);
+            _gap_start -= n;
+            _gap_end -= n;
+        } else if (pos > _gap_start) {
+            const auto n = pos - _gap_start;
+            std::memmove (_data.data() + _gap_start, _data.data() + _gap_end, n);
+            _gap_start += n;
+            _gap_end += n;
+        }
+    }
+
+    void grow (size_t needed) {
+        const auto tail     = _data.size() - _gap_end;
+        const auto capacity = std::max (_data.size() * 2, _data.size() + needed + 64);
+        _data.resize (capacity);
+        if (tail > 0)
+            std::memmove (_data.data() + capacity - tail, _data.data() + _gap_end, tail);
+        _gap_end = capacity - tail;
+    }
+};
+
+namespace utf8 {
+
+/** Returns the byte length of the code point starting with lead, or 0 if
+    lead is not a valid lead byte.
+ */
+static inline uint32_t sequence_length (uint8_t lead) noexcept {
+    if (lead < 0x80)
+        return 1;
+    if ((lead & 0xE0) == 0xC0)
+        return 2;
+    if ((lead & 0xF0) == 0xE0)
+        return 3;
+    if ((lead & 0xF8) == 0xF0)
+        return 4;
+    return 0;
+}
+
+} // namespace utf8
+} // namespace detail
+} // namespace lui
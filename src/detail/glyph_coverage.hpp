@@ -0,0 +1,180 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lui {
+namespace detail {
+
+/** A set of code points covered by a typeface.
+
+    Two level bitmap: a table of 256 code point blocks indexing in to a list
+    of 256 bit pages. Lookups are constant-time and only blocks with at least
+    one glyph cost memory.
+ */
+class GlyphCoverage {
+public:
+    static constexpr uint32_t max_codepoint = 0x10FFFF;
+
+    GlyphCoverage() : index ((max_codepoint >> 8) + 1, 0) {}
+
+    /** True if code point c is covered. */
+    bool contains (uint32_t c) const noexcept {
+        if (c > max_codepoint)
+            return false;
+        const auto page = index[c >> 8];
+        return page != 0 && ((pages[page - 1][(c & 0xff) >> 6] >> (c & 63)) & 1) != 0;
+    }
+
+    /** Mark code point c as covered. */
+    void add (uint32_t c) {
+        if (c > max_codepoint)
+            return;
+        auto& page = index[c >> 8];
+        if (page == 0) {
+            pages.push_back ({});
+            page = static_cast<uint16_t> (pages.size());
+        }
+        auto& bits      = pages[page - 1][(c & 0xff) >> 6];
+        const auto mask = uint64_t (1) << (c & 63);
+        if ((bits & mask) == 0) {
+            bits |= mask;
+            ++count;
+        }
+    }
+
+    /** Number of covered code points. */
+    size_t size() const noexcept { return count; }
+
+    /** True if nothing is covered. */
+    bool empty() const noexcept { return count == 0; }
+
+    /** Build coverage from the cmap of a TrueType/OpenType font in memory.
+        Supports cmap formats 4 and 12, and the first face of a collection.
+        Returns empty coverage if the data can't be parsed.
+     */
+    static GlyphCoverage from_font (const uint8_t* data, size_t size) {
+        GlyphCoverage cov;
+        Reader r { data, size };
+
+        size_t font = 0;
+        if (r.u32 (0) == 0x74746366) // 'ttcf'
+            font = r.u32 (12);
+
+        size_t cmap        = 0;
+        const auto ntables = r.u16 (font + 4);
+        for (uint32_t i = 0; i < ntables; ++i) {
+            const auto rec = font + 12 + i * 16;
+            if (r.u32 (rec) == 0x636d6170) { // 'cmap'
+                cmap = r.u32 (rec + 8);
+                break;
+            }
+        }
+        if (cmap == 0)
+            return cov;
+
+        // prefer full unicode (format 12) over the BMP only subtables.
+        size_t best      = 0;
+        int best_rank    = 0;
+        const auto nsubs = r.u16 (cmap + 2);
+        for (uint32_t i = 0; i < nsubs; ++i) {
+            const auto rec      = cmap + 4 + i * 8;
+            const auto platform = r.u16 (rec);
+            const auto encoding = r.u16 (rec + 2);
+            const auto sub      = cmap + r.u32 (rec + 4);
+            const auto format   = r.u16 (sub);
+
+            int rank = 0;
+            if (format == 12 && (platform == 0 || (platform == 3 && encoding == 10)))
+                rank = 2;
+            else if (format == 4 && (platform == 0 || (platform == 3 && encoding == 1)))
+                rank = 1;
+
+            if (rank > best_rank) {
+                best_rank = rank;
+                best      = sub;
+            }
+        }
+
+        if (best_rank == 2)
+            read_format12 (r, best, cov);
+        else if (best_rank == 1)
+            read_format4 (r, best, cov);
+
+        return cov;
+    }
+
+private:
+    using Page = std::array<uint64_t, 4>;
+    std::vector<uint16_t> index; // 1-based page per block, 0 when empty
+    std::vector<Page> pages;
+    size_t count = 0;
+
+    /** Bounds checked big-endian reads. Out of range reads return 0. */
+    struct Reader {
+        const uint8_t* data;
+        size_t size;
+
+        uint32_t u16 (size_t o) const noexcept {
+            return o + 2 <= size ? (uint32_t (data[o]) << 8) | data[o + 1] : 0;
+        }
+
+        uint32_t u32 (size_t o) const noexcept {
+            return o + 4 <= size ? (u16 (o) << 16) | u16 (o + 2) : 0;
+        }
+    };
+
+    static void read_format4 (const Reader& r, size_t sub, GlyphCoverage& cov) {
+        const auto segs   = r.u16 (sub + 6) / 2;
+        const auto ends   = sub + 14;
+        const auto starts = ends + segs * 2 + 2;
+        const auto deltas = starts + segs * 2;
+        const auto ranges = deltas + segs * 2;
+        if (ranges + segs * 2 > r.size)
+            return;
+
+        for (uint32_t i = 0; i < segs; ++i) {
+            const auto first  = r.u16 (starts + i * 2);
+            const auto last   = r.u16 (ends + i * 2);
+            const auto delta  = r.u16 (deltas + i * 2);
+            const auto offset = r.u16 (ranges + i * 2);
+
+            for (uint32_t c = first; c <= last && c < 0xFFFF; ++c) {
+                uint32_t glyph = 0;
+                if (offset == 0) {
+                    glyph = (c + delta) & 0xFFFF;
+                } else {
+                    glyph = r.u16 (ranges + i * 2 + offset + (c - first) * 2);
+                    if (glyph != 0)
+                        glyph = (glyph + delta) & 0xFFFF;
+                }
+                if (glyph != 0)
+                    cov.add (c);
+            }
+        }
+    }
+
+    static void read_format12 (const Reader& r, size_t sub, GlyphCoverage& cov) {
+        const auto ngroups = r.u32 (sub + 12);
+        for (uint32_t i = 0; i < ngroups; ++i) {
+            const auto group = sub + 16 + size_t (i) * 12;
+            if (group + 12 > r.size)
+                break;
+            auto first      = r.u32 (group);
+            const auto last = std::min (r.u32 (group + 4), max_codepoint);
+            if (r.u32 (group + 8) == 0) // first code point maps to .notdef
+                ++first;
+            for (uint32_t c = first; c <= last; ++c)
+                cov.add (c);
+        }
+    }
+};
+
+} // namespace detail
+} // namespace lui
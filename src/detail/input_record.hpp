@@ -0,0 +1,219 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace lui {
+namespace detail {
+
+/** One recorded view event.
+
+    Window system independent so recordings can be read and written without
+    pugl. Which fields are used depends on the type:
+
+    - CONFIGURE: x, y, dx (width), dy (height), code (style flags)
+    - TIMER: code (timer id)
+    - FOCUS_IN, FOCUS_OUT: code (crossing mode)
+    - KEY_PRESS, KEY_RELEASE: x, y, state, code (key), keycode
+    - TEXT: x, y, state, code (character), keycode, text
+    - POINTER_IN, POINTER_OUT: x, y, state, code (crossing mode)
+    - BUTTON_PRESS, BUTTON_RELEASE: x, y, state, code (button)
+    - MOTION: x, y, state
+    - SCROLL: x, y, state, code (direction), dx, dy
+ */
+struct InputRecord {
+    enum Type : uint8_t {
+        NONE = 0,
+        CONFIGURE,
+        UPDATE,
+        TIMER,
+        FOCUS_IN,
+        FOCUS_OUT,
+        KEY_PRESS,
+        KEY_RELEASE,
+        TEXT,
+        POINTER_IN,
+        POINTER_OUT,
+        BUTTON_PRESS,
+        BUTTON_RELEASE,
+        MOTION,
+        SCROLL
+    };
+
+    double time { 0.0 }; ///< Seconds since the recording started.
+    uint8_t type { NONE };
+    uint8_t flags { 0 };
+    uint32_t state { 0 };
+    uint32_t code { 0 };
+    uint32_t keycode { 0 };
+    float x { 0.f };
+    float y { 0.f };
+    float dx { 0.f };
+    float dy { 0.f };
+    char text[8] {};
+
+    /** Bytes per record in a file. */
+    static constexpr size_t encoded_size = 46;
+
+    /** Write this record little-endian to dst. */
+    void encode (uint8_t* dst) const noexcept {
+        uint64_t t;
+        std::memcpy (&t, &time, sizeof (t));
+        put (dst, t, 8);
+        dst[8] = type;
+        dst[9] = flags;
+        put (dst + 10, state, 4);
+        put (dst + 14, code, 4);
+        put (dst + 18, keycode, 4);
+        put_float (dst + 22, x);
+        put_float (dst + 26, y);
+        put_float (dst + 30, dx);
+        put_float (dst + 34, dy);
+        std::memcpy (dst + 38, text, sizeof (text));
+    }
+
+    /** Read a record written by encode(). */
+    static InputRecord decode (const uint8_t* src) noexcept {
+        InputRecord r;
+        const auto t = get (src, 8);
+        std::memcpy (&r.time, &t, sizeof (t));
+        r.type    = src[8];
+        r.flags   = src[9];
+        r.state   = static_cast<uint32_t> (get (src + 10, 4));
+        r.code    = static_cast<uint32_t> (get (src + 14, 4));
+        r.keycode = static_cast<uint32_t> (get (src + 18, 4));
+        r.x       = get_float (src + 22);
+        r.y       = get_float (src + 26);
+        r.dx      = get_float (src + 30);
+        r.dy      = get_float (src + 34);
+        std::memcpy (r.text, src + 38, sizeof (r.text));
+        r.text[sizeof (r.text) - 1] = '\0';
+        return r;
+    }
+
+private:
+    static void put (uint8_t* dst, uint64_t v, int nbytes) noexcept {
+        for (int i = 0; i < nbytes; ++i)
+            dst[i] = static_cast<uint8_t> (v >> (8 * i));
+    }
+
+    static uint64_t get (const uint8_t* src, int nbytes) noexcept {
+        uint64_t v = 0;
+        for (int i = 0; i < nbytes; ++i)
+            v |= uint64_t (src[i]) << (8 * i);
+        return v;
+    }
+
+    static void put_float (uint8_t* dst, float f) noexcept {
+        uint32_t v;
+        std::memcpy (&v, &f, sizeof (v));
+        put (dst, v, 4);
+    }
+
+    static float get_float (const uint8_t* src) noexcept {
+        const auto v = static_cast<uint32_t> (get (src, 4));
+        float f;
+        std::memcpy (&f, &v, sizeof (f));
+        return f;
+    }
+};
+
+/** Input recording file format.
+
+    A 12 byte header: the magic "LUIR", a version and the size of each
+    record, all little-endian. Followed by fixed size records until the end
+    of the file.
+ */
+namespace input_file {
+
+static constexpr char magic[4]      = { 'L', 'U', 'I', 'R' };
+static constexpr uint32_t version   = 1;
+static constexpr size_t header_size = 12;
+
+/** Read all records in a recording. Returns false if the file can't be
+    opened or isn't a recording.
+ */
+static inline bool read (const std::string& path, std::vector<InputRecord>& records) {
+    std::ifstream in (path, std::ios::binary);
+    if (! in)
+        return false;
+
+    uint8_t header[header_size];
+    if (! in.read (reinterpret_cast<char*> (header), header_size)
+        || std::memcmp (header, magic, sizeof (magic)) != 0)
+        return false;
+
+    const uint32_t ver  = header[4] | (header[5] << 8) | (header[6] << 16) | (uint32_t (header[7]) << 24);
+    const uint32_t size = header[8] | (header[9] << 8) | (header[10] << 16) | (uint32_t (header[11]) << 24);
+    if (ver != version || size < InputRecord::encoded_size)
+        return false;
+
+    records.clear();
+    std::vector<uint8_t> buffer (size);
+    while (in.read (reinterpret_cast<char*> (buffer.data()), (std::streamsize) size))
+        records.push_back (InputRecord::decode (buffer.data()));
+
+    return true;
+}
+
+} // namespace input_file
+
+/** Writes InputRecords to a file, stamping each with the time since
+    recording began.
+ */
+class InputRecorder {
+public:
+    InputRecorder() = default;
+
+    /** Start a new recording. Returns false if the file can't be created. */
+    bool open (const std::string& path) {
+        close();
+        out.open (path, std::ios::binary | std::ios::trunc);
+        if (! out)
+            return false;
+
+        uint8_t header[input_file::header_size];
+        std::memcpy (header, input_file::magic, sizeof (input_file::magic));
+        for (int i = 0; i < 4; ++i) {
+            header[4 + i] = static_cast<uint8_t> (input_file::version >> (8 * i));
+            header[8 + i] = static_cast<uint8_t> (InputRecord::encoded_size >> (8 * i));
+        }
+        out.write (reinterpret_cast<const char*> (header), sizeof (header));
+        start = clock::now();
+        return out.good();
+    }
+
+    /** Finish the recording. */
+    void close() {
+        if (out.is_open())
+            out.close();
+    }
+
+    /** True if a recording is open. */
+    bool recording() const noexcept { return out.is_open(); }
+
+    /** Append a record. Its time is set to now. */
+    void write (InputRecord record) {
+        if (! out.is_open())
+            return;
+        record.time = std::chrono::duration<double> (clock::now() - start).count();
+        uint8_t bytes[InputRecord::encoded_size];
+        record.encode (bytes);
+        out.write (reinterpret_cast<const char*> (bytes), sizeof (bytes));
+    }
+
+private:
+    using clock = std::chrono::steady_clock;
+    std::ofstream out;
+    clock::time_point start;
+};
+
+} // namespace detail
+} // namespace lui
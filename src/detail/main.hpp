@@ -4,16 +4,21 @@
 #pragma once
 
 #include <atomic>
+#include <cstring>
+#include <thread>
 
 #define PUGL_DISABLE_DEPRECATED
 #include <pugl/pugl.h>
 
+#include <lui/animator.hpp>
 #include <lui/button.hpp>
 #include <lui/main.hpp>
 #include <lui/slider.hpp>
 #include <lui/view.hpp>
 
+#include "detail/message_queue.hpp"
 #include "detail/view.hpp"
+#include "detail/waker.hpp"
 
 namespace lui {
 namespace detail {
@@ -26,8 +31,10 @@ static inline PuglWorldType world_type (Mode mode) {
     return PUGL_MODULE;
 }
 
-static inline PuglWorldFlags world_flags() {
-    return 0;
+static inline PuglWorldFlags world_flags (Mode mode) {
+    // programs own the process, so can make the window system thread safe
+    // for Main::post to wake the loop. Plugins leave that to the host.
+    return mode == Mode::PROGRAM ? PUGL_WORLD_THREADS : 0;
 }
 
 class Main {
@@ -43,6 +50,61 @@ public:
 
     bool loop (double timeout);
 
+    /** Repaint widgets whose last paint read a style entry in uses. */
+    void repaint_style_users (uint64_t uses);
+
+    /** Free caches of every view, and their render lists. */
+    void trim (TrimLevel level);
+
+    /** Queue a posted function. Any thread. */
+    bool post (MessageQueue::Handler handler, MessageQueue::Construct construct, void* source) noexcept {
+        if (! messages.push (handler, construct, source))
+            return false;
+        if (! wake_pending.exchange (true))
+            wake();
+        return true;
+    }
+
+    /** Run posted functions. UI thread only. */
+    size_t drain_posted() {
+        wake_pending.store (false);
+        return messages.drain (messages.capacity());
+    }
+
+    /** Use a realized view to wake the event loop from other threads. */
+    void set_wake_view (PuglView* view) {
+        PuglView* expected = nullptr;
+        wake_view.compare_exchange_strong (expected, view);
+    }
+
+    /** Stop waking with a view about to be unrealized. Waits for any thread
+        still sending to it, then wakes through another realized view.
+     */
+    void clear_wake_view (PuglView* view) {
+        PuglView* expected = view;
+        if (! wake_view.compare_exchange_strong (expected, nullptr))
+            return;
+        while (waking.load() > 0)
+            std::this_thread::yield();
+
+        for (auto other : views) {
+            auto pv = (PuglView*) other->c_obj();
+            if (pv != view && pv != nullptr && puglGetNativeView (pv) != 0) {
+                set_wake_view (pv);
+                break;
+            }
+        }
+    }
+
+    /** Hold view repaints until the matching end_repaints(), then post one
+        merged region per view. Calls may nest.
+     */
+    void begin_repaints() noexcept { ++repaint_depth; }
+    void end_repaints();
+
+    /** True while repaints are being held. */
+    bool repaints_held() const noexcept { return repaint_depth > 0; }
+
 private:
     friend class lui::Main;
     friend class lui::View;
@@ -54,11 +116,37 @@ private:
     std::unique_ptr<lui::Backend> backend;
     std::vector<lui::View*> views;
     std::unique_ptr<lui::Style> style;
+    std::unique_ptr<lui::Animator> animator;
+    int repaint_depth { 0 };
     bool quit_flag { false };
     std::atomic<int> exit_code { 0 };
 
     bool first_loop_called { false };
     PuglStatus last_update_status = PUGL_UNKNOWN_ERROR;
+
+    MessageQueue messages;
+    std::atomic<bool> wake_pending { false };
+    std::atomic<PuglView*> wake_view { nullptr };
+    std::atomic<int> waking { 0 };
+    // last, so it stops before anything it sends to goes away.
+    std::unique_ptr<Waker> waker;
+
+    void wake() noexcept {
+        if (waker != nullptr)
+            waker->wake();
+    }
+
+    /** Send the loop an event. Runs on the waker thread. */
+    void send_wake() {
+        ++waking;
+        if (auto view = wake_view.load()) {
+            PuglEvent ev;
+            std::memset (&ev, 0, sizeof (ev));
+            ev.client.type = PUGL_CLIENT;
+            puglSendEvent (view, &ev);
+        }
+        --waking;
+    }
 };
 
 } // namespace detail
@@ -0,0 +1,131 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace lui {
+namespace detail {
+
+/** A bounded, lock-free, multi-producer single-consumer queue of small
+    type-erased messages.
+
+    Cells are allocated up front, so pushing never allocates and fails
+    instead when the queue is full. Any thread may push; only one thread may
+    pop. Each cell carries a sequence number that tells producers when it is
+    free and the consumer when it is written (D. Vyukov's bounded queue).
+ */
+class MessageQueue {
+public:
+    /** Bytes of inline storage per message. */
+    static constexpr size_t storage_size = 48;
+
+    /** Invoke or destroy a message in place. Called with run false when
+        the message is discarded without running.
+     */
+    using Handler = void (*) (void* storage, bool run);
+
+    /** Move a message in to cell storage. */
+    using Construct = void (*) (void* storage, void* source);
+
+    /** Create a queue. Capacity is rounded up to a power of two. */
+    explicit MessageQueue (size_t capacity = 1024) {
+        size_t n = 2;
+        while (n < capacity)
+            n *= 2;
+        mask  = n - 1;
+        cells = std::make_unique<Cell[]> (n);
+        for (size_t i = 0; i < n; ++i)
+            cells[i].sequence.store (i, std::memory_order_relaxed);
+    }
+
+    ~MessageQueue() {
+        while (pop (false))
+            ;
+    }
+
+    /** Returns how many messages fit. */
+    size_t capacity() const noexcept { return mask + 1; }
+
+    /** Push a message from any thread. Returns false if full. */
+    bool push (Handler handler, Construct construct, void* source) noexcept {
+        auto pos = head.load (std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;) {
+            cell            = &cells[pos & mask];
+            const auto seq  = cell->sequence.load (std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t> (seq) - static_cast<intptr_t> (pos);
+            if (diff == 0) {
+                if (head.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = head.load (std::memory_order_relaxed);
+            }
+        }
+
+        construct (cell->storage, source);
+        cell->handler = handler;
+        cell->sequence.store (pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Pop and run (or discard) the oldest message. Consumer thread only.
+        Returns false if the queue was empty. If the message throws, its
+        cell is still released before the exception propagates.
+     */
+    bool pop (bool run = true) {
+        auto& cell = cells[tail & mask];
+        if (cell.sequence.load (std::memory_order_acquire) != tail + 1)
+            return false;
+
+        struct Release {
+            Cell& cell;
+            size_t sequence;
+            ~Release() { cell.sequence.store (sequence, std::memory_order_release); }
+        } release { cell, tail + mask + 1 };
+
+        const auto handler = cell.handler;
+        ++tail;
+        handler (cell.storage, run);
+        return true;
+    }
+
+    /** Run up to max_count messages that are ready. Returns how many ran.
+        Drained from event callbacks, so a message that throws is dropped
+        and the rest still run.
+     */
+    size_t drain (size_t max_count) {
+        size_t count = 0;
+        while (count < max_count) {
+            try {
+                if (! pop())
+                    break;
+            } catch (...) {
+            }
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence { 0 };
+        Handler handler { nullptr };
+        alignas (std::max_align_t) unsigned char storage[storage_size];
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask { 0 };
+    alignas (64) std::atomic<size_t> head { 0 };
+    alignas (64) size_t tail { 0 };
+};
+
+} // namespace detail
+} // namespace lui
@@ -0,0 +1,133 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+/** Set to 0 to allocate widget internals with plain new and delete. */
+#ifndef LUI_POOL_ALLOCATION
+#    define LUI_POOL_ALLOCATION 1
+#endif
+
+namespace lui {
+namespace detail {
+
+/** Small object pool for widget internals.
+
+    Blocks are grouped in 16 byte size classes and carved from 64 KiB
+    chunks, so objects created together sit next to each other in memory
+    and freed blocks are reused by the next object of the same class
+    without touching the heap. Larger requests go to operator new.
+
+    Free lists are per thread, matching how widgets are used, so a block
+    must be freed on the thread that allocated it. Anything whose lifetime
+    can end elsewhere, like the status block shared with WidgetRefs, stays
+    on the default allocator. Chunks are never returned to the system;
+    their blocks are reused instead.
+ */
+namespace pool {
+
+static constexpr size_t granularity = 16;
+static constexpr size_t max_block   = 512;
+static constexpr size_t num_classes = max_block / granularity;
+static constexpr size_t chunk_size  = 64 * 1024;
+
+static_assert (alignof (std::max_align_t) <= granularity);
+
+struct Stats {
+    size_t chunk_bytes { 0 }; ///< Bytes taken from the heap for chunks.
+    size_t used_bytes { 0 };  ///< Bytes in blocks handed out and not freed.
+};
+
+struct Pools {
+    struct Free {
+        Free* next;
+    };
+    Free* lists[num_classes] {};
+    char* cursor { nullptr };
+    size_t remaining { 0 };
+    Stats stats;
+};
+
+/** Returns the pools of the calling thread. */
+inline Pools& current() noexcept {
+    thread_local Pools pools;
+    return pools;
+}
+
+/** Allocate n bytes. */
+inline void* allocate (size_t n) {
+    if (LUI_POOL_ALLOCATION == 0 || n == 0 || n > max_block)
+        return ::operator new (n);
+
+    const auto index = (n - 1) / granularity;
+    const auto size  = (index + 1) * granularity;
+    auto& p          = current();
+    p.stats.used_bytes += size;
+
+    if (auto block = p.lists[index]) {
+        p.lists[index] = block->next;
+        return block;
+    }
+
+    if (p.remaining < size) {
+        p.cursor    = static_cast<char*> (::operator new (chunk_size));
+        p.remaining = chunk_size;
+        p.stats.chunk_bytes += chunk_size;
+    }
+
+    auto block = p.cursor;
+    p.cursor += size;
+    p.remaining -= size;
+    return block;
+}
+
+/** Free a block from allocate() of the same size. */
+inline void deallocate (void* ptr, size_t n) noexcept {
+    if (ptr == nullptr)
+        return;
+    if (LUI_POOL_ALLOCATION == 0 || n == 0 || n > max_block) {
+        ::operator delete (ptr);
+        return;
+    }
+
+    const auto index = (n - 1) / granularity;
+    auto& p          = current();
+    auto block       = static_cast<Pools::Free*> (ptr);
+    block->next      = p.lists[index];
+    p.lists[index]   = block;
+    p.stats.used_bytes -= (index + 1) * granularity;
+}
+
+/** An allocator for containers and shared pointers. */
+template <class T>
+struct Allocator {
+    using value_type = T;
+
+    Allocator() noexcept = default;
+    template <class U>
+    Allocator (const Allocator<U>&) noexcept {}
+
+    T* allocate (size_t n) { return static_cast<T*> (pool::allocate (n * sizeof (T))); }
+    void deallocate (T* ptr, size_t n) noexcept { pool::deallocate (ptr, n * sizeof (T)); }
+
+    template <class U>
+    bool operator== (const Allocator<U>&) const noexcept { return true; }
+    template <class U>
+    bool operator!= (const Allocator<U>&) const noexcept { return false; }
+};
+
+} // namespace pool
+} // namespace detail
+} // namespace lui
+
+/** Allocate instances of a class from the widget pool. */
+#define LUI_POOL_ALLOCATED                                                  \
+    static void* operator new (std::size_t n) {                             \
+        return lui::detail::pool::allocate (n);                             \
+    }                                                                       \
+    static void operator delete (void* ptr, std::size_t n) noexcept {       \
+        lui::detail::pool::deallocate (ptr, n);                             \
+    }
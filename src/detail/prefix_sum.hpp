@@ -0,0 +1,80 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace lui {
+namespace detail {
+
+/** A Fenwick (binary indexed) tree of running totals.
+
+    Point updates, prefix sums and "which item holds this offset" searches
+    are all O(log n), e.g. for rows of varying heights.
+ */
+template <typename Val>
+class PrefixSum {
+public:
+    PrefixSum() = default;
+
+    /** Rebuild from a list of values in O(n). */
+    void assign (const std::vector<Val>& values) {
+        tree.assign (values.size() + 1, Val());
+        for (size_t i = 1; i < tree.size(); ++i) {
+            tree[i] += values[i - 1];
+            const auto up = i + (i & (~i + 1));
+            if (up < tree.size())
+                tree[up] += tree[i];
+        }
+    }
+
+    /** Number of values. */
+    size_t size() const noexcept { return tree.empty() ? 0 : tree.size() - 1; }
+
+    /** Add delta to the value at index. */
+    void add (size_t index, Val delta) noexcept {
+        for (auto i = index + 1; i < tree.size(); i += i & (~i + 1))
+            tree[i] += delta;
+    }
+
+    /** Sum of the first count values. */
+    Val sum (size_t count) const noexcept {
+        Val total {};
+        for (auto i = std::min (count, size()); i > 0; i -= i & (~i + 1))
+            total += tree[i];
+        return total;
+    }
+
+    /** Sum of all values. */
+    Val total() const noexcept { return sum (size()); }
+
+    /** Returns the index of the value containing offset, i.e. the largest
+        index where sum (index) <= offset. Returns size() if offset is at or
+        past the total. Values must not be negative.
+     */
+    size_t find (Val offset) const noexcept {
+        size_t pos  = 0;
+        size_t step = 1;
+        while (step * 2 < tree.size())
+            step *= 2;
+
+        for (; step > 0; step /= 2) {
+            const auto next = pos + step;
+            if (next < tree.size() && tree[next] <= offset) {
+                pos = next;
+                offset -= tree[next];
+            }
+        }
+
+        return pos;
+    }
+
+private:
+    std::vector<Val> tree; // 1-based
+};
+
+} // namespace detail
+} // namespace lui
@@ -0,0 +1,50 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <type_traits>
+
+#include "pugl/src/types.h"
+
+namespace lui {
+namespace detail {
+
+/** Wraps a pugl graphics backend to hear when frames are presented.
+
+    Backends swap or flush a frame in leave(), after the expose handler
+    returned, so anything timed from the handler misses the present. The
+    view is given the wrapped backend instead, and the callback runs once
+    the real leave() is done with a drawn frame.
+ */
+struct Presenter {
+    using Callback = void (*) (void* data);
+
+    PuglBackend backend {}; // pugl hands this back, so it stays first.
+    const PuglBackend* base { nullptr };
+    Callback presented { nullptr };
+    void* data { nullptr };
+
+    /** Wrap a backend. The presenter must outlive the views using it. */
+    void wrap (const PuglBackend* b, Callback callback, void* callback_data) noexcept {
+        base          = b;
+        presented     = callback;
+        data          = callback_data;
+        backend       = *b;
+        backend.leave = &Presenter::leave;
+    }
+
+private:
+    static PuglStatus leave (PuglView* view, const PuglExposeEvent* expose) {
+        auto self         = reinterpret_cast<const Presenter*> (view->backend);
+        const auto status = self->base->leave (view, expose);
+        if (expose != nullptr && status == PUGL_SUCCESS && self->presented != nullptr)
+            self->presented (self->data);
+        return status;
+    }
+};
+
+static_assert (std::is_standard_layout_v<Presenter>);
+
+} // namespace detail
+} // namespace lui
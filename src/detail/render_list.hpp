@@ -0,0 +1,173 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <lui/graphics.hpp>
+#include <lui/widget.hpp>
+
+namespace lui {
+namespace detail {
+
+/** Pixels of an area painted over by opaque widgets.
+
+    Stored as 8x8 blocks of cell bits so marking and testing a rectangle
+    costs its area over 64 cells. Cells grow past one pixel to keep the
+    mask under 64K cells; a cell is only marked when fully covered, so
+    coarse cells hide less but never hide too much.
+ */
+class CoverageMask {
+public:
+    /** Clear the mask and cover a new area. */
+    void reset (Bounds area) {
+        _area = area;
+        _cell = 1;
+        if (area.empty()) {
+            _tiles_x = _tiles_y = 0;
+            _tiles.clear();
+            return;
+        }
+
+        const auto pixels = int64_t (area.width) * int64_t (area.height);
+        while (pixels / (int64_t (_cell) * _cell) > max_cells)
+            ++_cell;
+        _tiles_x = (cells (area.width) + 7) / 8;
+        _tiles_y = (cells (area.height) + 7) / 8;
+        _tiles.assign (size_t (_tiles_x) * size_t (_tiles_y), 0);
+    }
+
+    /** Mark the cells completely inside r. */
+    void add (Bounds r) {
+        r = r.intersection (_area);
+        if (r.empty())
+            return;
+        // round inward so partly covered cells stay clear.
+        const int x1 = ceil_div (r.x - _area.x), x2 = (r.x + r.width - _area.x) / _cell;
+        const int y1 = ceil_div (r.y - _area.y), y2 = (r.y + r.height - _area.y) / _cell;
+        each_tile (x1, y1, x2, y2, [] (uint64_t& tile, uint64_t bits) { tile |= bits; return true; });
+    }
+
+    /** Returns true if every cell touching r is marked. */
+    bool covers (Bounds r) {
+        if (_tiles.empty())
+            return false;
+        r = r.intersection (_area);
+        if (r.empty())
+            return true;
+        // round outward so partly visible cells count.
+        const int x1 = (r.x - _area.x) / _cell, x2 = ceil_div (r.x + r.width - _area.x);
+        const int y1 = (r.y - _area.y) / _cell, y2 = ceil_div (r.y + r.height - _area.y);
+        return each_tile (x1, y1, x2, y2, [] (uint64_t& tile, uint64_t bits) { return (tile & bits) == bits; });
+    }
+
+    /** Pixels per cell side. */
+    int cell_size() const noexcept { return _cell; }
+
+    /** Returns the bytes held by the mask. */
+    size_t memory_size() const noexcept { return _tiles.capacity() * sizeof (uint64_t); }
+
+private:
+    static constexpr int64_t max_cells = 1 << 16;
+
+    Bounds _area;
+    int _cell { 1 };
+    int _tiles_x { 0 }, _tiles_y { 0 };
+    std::vector<uint64_t> _tiles;
+
+    int cells (int pixels) const noexcept { return ceil_div (pixels); }
+    int ceil_div (int pixels) const noexcept { return (pixels + _cell - 1) / _cell; }
+
+    /** Call fn with every tile and the bits of cells x1..x2, y1..y2
+        (exclusive) in it, until fn returns false.
+     */
+    template <class Fn>
+    bool each_tile (int x1, int y1, int x2, int y2, Fn&& fn) {
+        if (x1 >= x2 || y1 >= y2)
+            return true;
+        for (int ty = y1 / 8; ty <= (y2 - 1) / 8; ++ty) {
+            const int r1    = std::max (y1 - ty * 8, 0);
+            const int r2    = std::min (y2 - ty * 8, 8);
+            const auto rows = row_bits (r1, r2);
+            for (int tx = x1 / 8; tx <= (x2 - 1) / 8; ++tx) {
+                const int c1 = std::max (x1 - tx * 8, 0);
+                const int c2 = std::min (x2 - tx * 8, 8);
+                // one byte per row, so multiplying repeats the columns.
+                const auto bits = column_bits (c1, c2) * rows;
+                if (! fn (_tiles[size_t (ty) * size_t (_tiles_x) + size_t (tx)], bits))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /** Bits of columns first..last in a row's byte. */
+    static uint64_t column_bits (int first, int last) noexcept {
+        return ((uint64_t (1) << last) - 1) & ~((uint64_t (1) << first) - 1);
+    }
+
+    /** The low bit of the bytes of rows first..last. */
+    static uint64_t row_bits (int first, int last) noexcept {
+        uint64_t bits = 0;
+        for (int i = first; i < last; ++i)
+            bits |= uint64_t (1) << (i * 8);
+        return bits;
+    }
+};
+
+/** A widget tree flattened in paint order, with occlusion resolved.
+
+    build() walks the tree once, in paint order, recording where every
+    widget sits relative to the root and the area it may paint. A second
+    pass runs front to back over a CoverageMask of the opaque widgets
+    already seen: a widget whose area is all marked is dropped, otherwise
+    it marks its own area if opaque. Each widget is visited once, at a
+    cost bounded by its area.
+
+    The list is kept until the tree changes, so most frames only iterate
+    it, skipping entries outside the area being repainted.
+ */
+class RenderList {
+public:
+    struct Entry {
+        lui::Widget* widget { nullptr };
+        WidgetHandle handle;    // to detect widgets deleted while painting
+        Point<int> origin;      // position relative to the root
+        Bounds clip;            // area it may paint, relative to the root
+        Bounds cover;           // area it paints over if opaque, or empty
+        bool clipped { true };  // clip to `clip` before painting
+    };
+
+    /** Flatten the tree of root and resolve occlusion. */
+    void build (lui::Widget& root);
+
+    /** Returns true if the tree of root changed since the last build. */
+    bool stale (const lui::Widget& root) const noexcept;
+
+    /** Paint every entry inside the current clip of g. */
+    void render (Graphics& g);
+
+    /** Returns the entries left to paint, in paint order. */
+    std::span<const Entry> entries() const noexcept { return _entries; }
+
+    /** Returns the bytes held by the list. */
+    size_t memory_size() const noexcept {
+        return sizeof (RenderList) + _entries.capacity() * sizeof (Entry) + _mask.memory_size();
+    }
+
+private:
+    std::vector<Entry> _entries;
+    CoverageMask _mask;
+    Bounds _area;
+    uint64_t _generation { ~uint64_t (0) };
+
+    void add (lui::Widget& widget, Point<int> origin, Bounds clip, bool clipped);
+    void occlude();
+};
+
+} // namespace detail
+} // namespace lui
@@ -0,0 +1,191 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include <lui/graphics.hpp>
+#include <lui/string.hpp>
+
+#include "detail/gap_buffer.hpp"
+
+namespace lui {
+namespace detail {
+
+/** A line of editable UTF-8 text with a caret.
+
+    Text lives in a GapBuffer and the caret is a byte offset, so typing,
+    deleting and moving the caret cost O(1) whatever the line length. Caret
+    geometry comes from the backend's layout of the whole string, the same
+    layout used to draw it, so kerning and shaping line up. It is rebuilt by
+    layout() only after the text changed, at the cost of drawing the string.
+
+    Between an edit and the next layout(), positions before the edit are
+    still known, which is enough to work out what to repaint.
+ */
+class TextLine {
+public:
+    /** Number of bytes of text. */
+    size_t size() const noexcept { return _buffer.size(); }
+
+    /** The caret position, a byte offset on a code point boundary. */
+    size_t caret() const noexcept { return _caret; }
+
+    /** Move the caret, snapping back to a code point boundary. */
+    void set_caret (size_t pos) noexcept {
+        pos = std::min (pos, size());
+        while (pos > 0 && pos < size() && continuation (pos))
+            --pos;
+        _caret = pos;
+    }
+
+    /** Returns the code point boundary after pos. */
+    size_t next (size_t pos) const noexcept {
+        return pos < size() ? std::min (size(), pos + std::max (1u, utf8::sequence_length (static_cast<uint8_t> (_buffer[pos])))) : size();
+    }
+
+    /** Returns the code point boundary before pos. */
+    size_t prev (size_t pos) const noexcept {
+        if (pos == 0)
+            return 0;
+        --pos;
+        while (pos > 0 && continuation (pos))
+            --pos;
+        return pos;
+    }
+
+    /** Returns the whole text. */
+    const lui::String& text() {
+        if (_text_dirty) {
+            _text       = _buffer.text();
+            _text_dirty = false;
+        }
+        return _text;
+    }
+
+    /** Replace the text and put the caret at the end. */
+    void set_text (std::string_view input) {
+        _buffer.clear();
+        _caret = 0;
+        changed (0);
+        insert (input);
+    }
+
+    /** Insert the valid, printable code points of input at the caret and
+        move the caret past them. Returns false if nothing was inserted.
+     */
+    bool insert (std::string_view input) {
+        std::string bytes;
+        bytes.reserve (input.size());
+
+        for (size_t i = 0; i < input.size();) {
+            const auto lead = static_cast<uint8_t> (input[i]);
+            auto len        = utf8::sequence_length (lead);
+            bool ok         = len > 0 && i + len <= input.size();
+            for (uint32_t j = 1; ok && j < len; ++j)
+                ok = (static_cast<uint8_t> (input[i + j]) & 0xC0) == 0x80;
+
+            if (! ok) {
+                ++i;
+                continue;
+            }
+
+            if (len > 1 || (lead >= ' ' && lead != 0x7f))
+                bytes.append (input.data() + i, len);
+            i += len;
+        }
+
+        if (bytes.empty())
+            return false;
+
+        _buffer.insert (_caret, bytes);
+        changed (_caret);
+        _caret += bytes.size();
+        return true;
+    }
+
+    /** Erase the code point starting at pos. */
+    void erase (size_t pos) {
+        if (pos >= size())
+            return;
+        _buffer.erase (pos, next (pos) - pos);
+        changed (pos);
+        if (_caret > pos)
+            set_caret (pos);
+    }
+
+    /** True if the text changed since the last layout(). */
+    bool needs_layout() const noexcept { return _layout_dirty; }
+
+    /** Lay the text out in the current font of dc. */
+    void layout (const DrawingContext& dc) {
+        if (! needs_layout())
+            return;
+        const std::string_view str (text().c_str(), text().size());
+        dc.text_positions (str, _xs);
+
+        _stops.clear();
+        size_t index = 0;
+        for (size_t i = 0; i < str.size(); ++i)
+            if ((static_cast<uint8_t> (str[i]) & 0xC0) != 0x80)
+                _stops.push_back ({ i, index < _xs.size() ? _xs[index++] : 0.f });
+        _stops.push_back ({ str.size(), _xs.empty() ? 0.f : _xs.back() });
+        _valid        = str.size();
+        _layout_dirty = false;
+    }
+
+    /** Forget the layout, for instance when the font changes. */
+    void invalidate() noexcept { changed (0); }
+
+    /** Returns the x offset of pos, or of the last position still known
+        if the text changed after it.
+     */
+    float x_of (size_t pos) const noexcept {
+        pos     = std::min (pos, _valid);
+        auto it = std::upper_bound (_stops.begin(), _stops.end(), pos, [] (size_t p, const Stop& s) { return p < s.pos; });
+        return it == _stops.begin() ? 0.f : (it - 1)->x;
+    }
+
+    /** Returns the caret position nearest to x, among those still known. */
+    size_t hit (float x) const noexcept {
+        auto end = std::upper_bound (_stops.begin(), _stops.end(), _valid, [] (size_t p, const Stop& s) { return p < s.pos; });
+        auto it  = std::upper_bound (_stops.begin(), end, x, [] (float v, const Stop& s) { return v < s.x; });
+        if (it == _stops.begin())
+            return 0;
+        if (it == end)
+            return (it - 1)->pos;
+        return (x - (it - 1)->x) < (it->x - x) ? (it - 1)->pos : it->pos;
+    }
+
+private:
+    struct Stop {
+        size_t pos; // byte offset
+        float x;
+    };
+
+    GapBuffer _buffer;
+    size_t _caret { 0 };
+    std::vector<Stop> _stops;
+    std::vector<float> _xs; // scratch for text_positions
+    size_t _valid { 0 };    // stops up to here match the text
+
+    lui::String _text;
+    bool _text_dirty { false };
+    bool _layout_dirty { true };
+
+    bool continuation (size_t pos) const noexcept {
+        return (static_cast<uint8_t> (_buffer[pos]) & 0xC0) == 0x80;
+    }
+
+    void changed (size_t pos) noexcept {
+        _valid        = std::min (_valid, pos);
+        _text_dirty   = true;
+        _layout_dirty = true;
+    }
+};
+
+} // namespace detail
+} // namespace lui
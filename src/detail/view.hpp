@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <span>
 
 #include <lui/input.hpp>
 #include <lui/main.hpp>
@@ -15,7 +16,11 @@
 #define PUGL_DISABLE_DEPRECATED
 #include <pugl/pugl.h>
 
+#include "detail/frame.hpp"
+#include "detail/frame_latency.hpp"
+#include "detail/input_record.hpp"
 #include "detail/main.hpp"
+#include "detail/presenter.hpp"
 #include "detail/widget.hpp"
 
 #ifndef LUI_DISABLE_CLIPPING
@@ -90,29 +95,6 @@ static Event event (lui::Main& m,
              num_clicks };
 }
 
-static Event event (lui::Main& m,
-                    lui::Widget& src,
-                    lui::Widget& tgt,
-                    Point<float> pos) {
-    return event (m, src, tgt, Modifier(), pos, 0);
-}
-
-static Event event (lui::Main& m,
-                    lui::Widget& src,
-                    lui::Widget& tgt,
-                    Modifier mods,
-                    Point<float> pos,
-                    Point<float> last_pos,
-                    int num_clicks) {
-    return { m,
-             tgt.convert (&src, pos),
-             tgt.convert (&src, last_pos),
-             mods,
-             &src,
-             &tgt,
-             num_clicks };
-}
-
 } // namespace input
 
 /** A key event */
@@ -342,7 +324,14 @@ public:
     ~View();
 
     void set_backend (uintptr_t b) {
-        puglSetBackend (view, (PuglBackend*) b);
+        presenter.wrap ((const PuglBackend*) b, &View::frame_presented, this);
+        puglSetBackend (view, &presenter.backend);
+    }
+
+    /** Called after the backend presented a frame. */
+    static void frame_presented (void* data) {
+        auto self = static_cast<View*> (data);
+        self->latency.presented (self->now());
     }
 
     void set_view_hint (int k, int v) {
@@ -365,18 +354,155 @@ public:
         lui::ignore (status);
     }
 
-    void drag_pressed_widgets (Point<float> pos) {
+    void drag_pressed_widgets (Point<float> pos, std::span<const Point<float>> samples) {
         for (int i = 0; i < LUI_MAX_BUTTONS; ++i) {
             if (! buttons.is_down (i))
                 continue;
             if (auto w = buttons.target (i)) {
-                auto ldp = last_down_pos;
-                auto ev  = input::event (main, widget, *w, Modifier(), pos, ldp, 0);
+                const auto local = w->convert (&widget, pos);
+                Event ev (main,
+                          local,
+                          w->convert (&widget, last_down_pos),
+                          Modifier(),
+                          &widget,
+                          w,
+                          0,
+                          to_local (samples, local - pos));
                 w->drag (ev);
             }
         }
     }
 
+    /** Buffers a pointer position until the next update, or until another
+        event needs it to be current. High rate mice and tablets deliver far
+        more motion than can be drawn, so widgets see one motion per frame
+        with the positions in between available as Event::samples.
+     */
+    void queue_motion (Point<float> pos) {
+        if (pending_motion.size() >= max_motion_samples)
+            flush_motion();
+        if (pending_motion.empty() && latency.enabled())
+            motion_time = now();
+        pending_motion.push_back (pos);
+    }
+
+    /** Dispatch buffered motion, if any. */
+    void flush_motion() {
+        if (pending_motion.empty())
+            return;
+        std::swap (pending_motion, flushing_motion);
+        const auto previous_time = latency.input();
+        latency.set_input (motion_time);
+        handle_motion (flushing_motion.back(), flushing_motion);
+        latency.set_input (previous_time);
+        flushing_motion.clear();
+    }
+
+    /** Seconds on the world clock. */
+    double now() const noexcept { return puglGetTime (puglGetWorld (view)); }
+
+    bool start_recording (const std::string& path) {
+        auto rec = std::make_unique<InputRecorder>();
+        if (! rec->open (path))
+            return false;
+        recorder = std::move (rec);
+        return true;
+    }
+
+    void stop_recording() {
+        recorder.reset();
+    }
+
+    /** Queue a recording to play back from the frame loop. */
+    int replay (const std::string& path, bool realtime) {
+        std::vector<InputRecord> records;
+        if (! input_file::read (path, records))
+            return -1;
+
+        // frames come from the loop, recorded ones aren't replayed.
+        std::erase_if (records, [] (const InputRecord& r) {
+            return r.type == InputRecord::NONE || r.type == InputRecord::UPDATE;
+        });
+
+        replay_records  = std::move (records);
+        replay_next     = 0;
+        replay_realtime = realtime;
+        replay_start    = now();
+        return static_cast<int> (replay_records.size());
+    }
+
+    bool replaying() const noexcept { return replay_next < replay_records.size(); }
+
+    /** Dispatch the recorded events due this frame: the next one, or every
+        one whose time has come when playing in realtime. Runs before the
+        frame is exposed, so what they change is rendered straight after.
+     */
+    void advance_replay() {
+        const auto elapsed = now() - replay_start;
+        for (bool first = true; replaying(); first = false) {
+            // a copy, dispatching may start another replay.
+            const auto r = replay_records[replay_next];
+            if (replay_realtime ? r.time > elapsed : ! first)
+                break;
+            ++replay_next;
+            PuglEvent ev;
+            if (from_record (r, ev))
+                dispatch (view, &ev);
+        }
+
+        flush_motion();
+        if (! replaying() && ! replay_records.empty()) {
+            replay_records.clear();
+            replay_records.shrink_to_fit();
+            replay_next = 0;
+        }
+    }
+
+    /** Merge an area in to the held repaint region. Empty means all. */
+    void add_damage (Bounds area) noexcept {
+        if (area.empty())
+            full_damage = true;
+        else if (damage.empty())
+            damage = area;
+        else {
+            const auto x1 = std::min (damage.x, area.x);
+            const auto y1 = std::min (damage.y, area.y);
+            const auto x2 = std::max (damage.x + damage.width, area.x + area.width);
+            const auto y2 = std::max (damage.y + damage.height, area.y + area.height);
+            damage        = { x1, y1, x2 - x1, y2 - y1 };
+        }
+    }
+
+    /** Post the held repaint region. */
+    void flush_damage() {
+        if (! full_damage && damage.empty())
+            return;
+        const auto area = full_damage ? Bounds() : damage;
+        full_damage     = false;
+        damage          = {};
+        owner.repaint (area);
+    }
+
+    /** Run functions posted to Main. */
+    void drain_posted();
+
+    /** Give the widget a size received in a configure event. Repaints it
+        causes are dropped, the whole view is painted after.
+        @returns true if there was a size to apply
+     */
+    bool apply_pending_bounds();
+
+    /** End a live resize with a full quality layout and paint. */
+    void resize_settled() {
+        live_resizing = false;
+        apply_pending_bounds();
+        widget.resized();
+        owner.repaint ({});
+    }
+
+    /** Register or unregister this view for waking the loop. */
+    void realized (bool is_realized);
+
     void set_focused_widget (lui::Widget* widget) {
         if (focused == widget)
             return;
@@ -390,7 +516,7 @@ public:
     template <class Fn>
     static void foreach_widget_recursive (lui::Widget& widget, Fn&& f) {
         f (widget);
-        for (auto w : widget.impl->widgets)
+        for (auto w : widget.impl->children())
             foreach_widget_recursive (*w, f);
     }
 
@@ -402,18 +528,125 @@ public:
 private:
     friend class lui::View;
     friend class lui::Main;
+    friend class detail::Main;
 
     lui::View& owner;
     lui::Main& main;
     lui::Widget& widget;
     PuglView* view { nullptr };
-    WeakRef<lui::Widget> hovered;
-    WeakRef<lui::Widget> focused;
+    WidgetHandle hovered;
+    WidgetHandle focused;
     Buttons buttons;
     Keyboard keyboard;
 
     Point<float> last_down_pos;
 
+    static constexpr size_t max_motion_samples = 256;
+    std::vector<Point<float>> pending_motion;  // view coordinates
+    std::vector<Point<float>> flushing_motion; // view coordinates
+    std::vector<Point<float>> local_motion;    // target coordinates
+
+    std::unique_ptr<InputRecorder> recorder;
+    std::vector<InputRecord> replay_records;
+    size_t replay_next { 0 };
+    double replay_start { 0.0 };
+    bool replay_realtime { false };
+
+    Presenter presenter;
+    FrameLatency latency;
+    Bounds damage;
+    bool full_damage { false };
+    double motion_time { -1.0 }; // arrival of the oldest pending motion
+
+    // Where the hovered widget can be hit without a tree walk. Only valid
+    // while the widget tree generation is unchanged.
+    WidgetHandle hover_hit;
+    Bounds hover_area;
+    Point<float> hover_origin;
+    uint64_t hover_generation { 0 };
+    bool hover_cached { false };
+
+    std::span<const Point<float>> to_local (std::span<const Point<float>> samples, Point<float> delta) {
+        local_motion.clear();
+        for (const auto& s : samples)
+            local_motion.push_back (s + delta);
+        return local_motion;
+    }
+
+    /** Caches the region where `hit` is the topmost widget: its bounds
+        clipped by every ancestor, provided no sibling in front of it along
+        the way overlaps it.
+     */
+    void cache_hover (lui::Widget* hit) {
+        hover_cached = false;
+        if (hit == nullptr || hit->impl->num_children() > 0)
+            return;
+
+        auto area = hit->bounds().at (0);
+        for (auto c = hit; c != &widget; c = c->parent()) {
+            auto p = c->parent();
+            if (p == nullptr)
+                return;
+            area = area.at (area.x + c->x(), area.y + c->y()).intersection (p->bounds().at (0));
+            auto& siblings = p->impl->children();
+            for (auto i = (size_t) c->impl->index + 1; i < siblings.size(); ++i) {
+                auto s = siblings[i];
+                if (s->visible() && s->bounds().intersects (area))
+                    return;
+            }
+        }
+
+        hover_hit        = hit;
+        hover_area       = area;
+        hover_origin     = hit->to_view_space (Point<float>());
+        hover_generation = detail::Widget::generation();
+        hover_cached     = true;
+    }
+
+    /** Returns the widget at pos in view coordinates. Skips the tree walk
+        while the pointer stays inside the cached hover area.
+     */
+    lui::Widget* hit_test (Point<float> pos) {
+        if (hover_cached && hover_generation == detail::Widget::generation()) {
+            auto h = hover_hit.lock();
+            if (h != nullptr && hover_area.contains (pos.as<int>())
+                && test_pos (*h, pos - hover_origin))
+                return h;
+        }
+
+        auto hit = widget.widget_at (pos);
+        cache_hover (hit);
+        return hit;
+    }
+
+    void handle_motion (Point<float> pos, std::span<const Point<float>> samples) {
+        WidgetHandle ref = hit_test (pos);
+
+        if (auto w = ref.lock()) {
+            const auto local = w->convert (&widget, pos);
+            Event ev (main, local, local, Modifier(), &widget, w, 0, to_local (samples, local - pos));
+            if (hovered != w) {
+                VIEW_DBG3 ("hovered changed: " << w->name());
+                w->enter (ev);
+                hovered = w;
+            }
+
+            w->motion (ev);
+        } else if (hovered) {
+            VIEW_DBG3 ("hovered cleared");
+            if (auto h = hovered.lock()) {
+                auto cpos  = h->convert (&widget, pos);
+                cpos.x     = std::min (std::max (0.f, cpos.x), (float) h->width());
+                cpos.y     = std::min (std::max (0.f, cpos.y), (float) h->height());
+                auto event = Event (main, cpos, Modifier(), h, h, 0);
+                h->exit (event);
+            }
+            hovered = nullptr;
+        }
+
+        drag_pressed_widgets (pos, samples);
+    }
+
     template <typename T>
     struct ScopedInc {
         explicit ScopedInc (T& val) : value (val), original (val) {}
@@ -428,6 +661,13 @@ private:
     int nconfigures   = 0;
     bool configure_pending { false };
 
+    /** Seconds without a new size before a live resize is over. */
+    static constexpr double resize_settle_time = 0.15;
+    Bounds pending_bounds;
+    bool bounds_pending { false };
+    bool live_resizing { false };
+    double last_configure { -1.0 };
+
     static PuglStatus configure (View& view, const PuglConfigureEvent& ev) {
         ScopedInc nconfigs (view.nconfigures);
 
@@ -469,10 +709,28 @@ private:
             VIEW_DBG ("handled pending configure");
         }
 
-        widget.set_bounds (int ((float) ev.x / view.scale_factor()),
-                           int ((float) ev.y / view.scale_factor()),
-                           int (static_cast<float> (ev.width) / view.scale_factor()),
-                           int (static_cast<float> (ev.height)) / view.scale_factor());
+        const Bounds bounds { int ((float) ev.x / view.scale_factor()),
+                              int ((float) ev.y / view.scale_factor()),
+                              int (static_cast<float> (ev.width) / view.scale_factor()),
+                              int (static_cast<float> (ev.height) / view.scale_factor()) };
+
+        // sizes arriving faster than the settle time are a live resize.
+        // those are laid out once, right before the next frame is painted.
+        const auto t            = view.now();
+        const bool size_changed = bounds.width != widget.width() || bounds.height != widget.height();
+        if (size_changed && view.last_configure >= 0.0 && t - view.last_configure < resize_settle_time)
+            view.live_resizing = true;
+        if (size_changed)
+            view.last_configure = t;
+
+        if (view.live_resizing) {
+            view.pending_bounds = bounds;
+            view.bounds_pending = true;
+            puglPostRedisplay (view.view);
+        } else {
+            view.bounds_pending = false;
+            widget.set_bounds (bounds);
+        }
 
         return PUGL_SUCCESS;
     }
@@ -494,18 +752,27 @@ private:
         auto h = (float) ev.height / view.scale_factor();
         auto r = Rectangle<float> { x, y, w, h }.as<int>();
 
+        if (view.apply_pending_bounds())
+            r = view.owner.bounds().at (0);
+
         // view.owner.expose (detail::rect<int> (ev));
         view.owner.expose (r.intersection (view.owner.bounds().at (0)));
+
+        // sampled once the backend presents it.
+        view.latency.exposed();
+
         return PUGL_SUCCESS;
     }
 
     static PuglStatus create (View& view, const PuglRealizeEvent& ev) {
+        view.realized (true);
         view.owner.created();
         puglStartTimer (view.view, 0, 14.0 / 1000.0);
         return PUGL_SUCCESS;
     }
 
     static PuglStatus destroy (View& view, const PuglUnrealizeEvent& ev) {
+        view.realized (false);
         puglStopTimer (view.view, 0);
         view.owner.destroyed();
         return PUGL_SUCCESS;
@@ -520,6 +787,8 @@ private:
     // }
 
     static PuglStatus update (View& view, const PuglUpdateEvent& ev) {
+        if (view.replaying())
+            view.advance_replay();
         return PUGL_SUCCESS;
     }
 
@@ -602,32 +871,7 @@ private:
     }
 
     static PuglStatus motion (View& view, const PuglMotionEvent& ev) {
-        const auto pos = detail::point<float> (ev) / view.scale_factor();
-        WidgetRef ref  = view.widget.widget_at (pos);
-
-        if (ref.valid()) {
-            auto ev = input::event (view.main, view.widget, *ref, pos);
-            if (view.hovered != ref) {
-                VIEW_DBG3 ("hovered changed: " << ref->name());
-                ref->enter (ev);
-                view.hovered = ref;
-            }
-
-            ref->motion (ev);
-        } else if (view.hovered) {
-            VIEW_DBG3 ("hovered cleared");
-            if (auto h = view.hovered.lock()) {
-                auto cpos  = h->convert (&view.widget, pos);
-                cpos.x     = std::min (std::max (0.f, cpos.x), (float) h->width());
-                cpos.y     = std::min (std::max (0.f, cpos.y), (float) h->height());
-                auto event = Event (view.main, cpos, Modifier(), h, h, 0);
-                h->exit (event);
-            }
-            view.hovered = nullptr;
-        }
-
-        view.drag_pressed_widgets (pos);
-
+        view.queue_motion (detail::point<float> (ev) / view.scale_factor());
         return PUGL_SUCCESS;
     }
 
@@ -681,11 +925,35 @@ private:
         return PUGL_SUCCESS;
     }
 
-    static PuglStatus scroll (View& view, const PuglScrollEvent& ev) { return PUGL_SUCCESS; }
-    static PuglStatus client (View& view, const PuglClientEvent& ev) { return PUGL_SUCCESS; }
+    static PuglStatus scroll (View& view, const PuglScrollEvent& ev) {
+        const auto pos   = detail::point<float> (ev) / view.scale_factor();
+        const auto delta = Point<float> { (float) ev.dx, (float) ev.dy };
+
+        WidgetHandle ref = view.hit_test (pos);
+        while (auto w = ref.lock()) {
+            ScrollEvent sev (w->convert (&view.widget, pos), delta, Modifier (ev.state));
+            if (w->scroll (sev) || ! ref.valid())
+                break;
+            ref = w->parent();
+        }
+
+        return PUGL_SUCCESS;
+    }
+    static PuglStatus client (View& view, const PuglClientEvent& ev) {
+        view.drain_posted();
+        return PUGL_SUCCESS;
+    }
 
     static PuglStatus timer (View& view, const PuglTimerEvent& ev) {
-        // TODO: notify idle handlers.
+        view.drain_posted();
+        // hidden views get no updates, replay on the timer instead.
+        if (view.replaying() && ! puglGetVisible (view.view))
+            view.advance_replay();
+        if (view.apply_pending_bounds())
+            view.owner.repaint ({});
+        if (view.live_resizing && view.now() - view.last_configure >= resize_settle_time)
+            view.resize_settled();
+        FrameTasks::current().tick (view.now());
         return PUGL_SUCCESS;
     }
 
@@ -695,10 +963,191 @@ private:
     static PuglStatus data (View& view, const PuglDataEvent& ev) { return PUGL_SUCCESS; }
     static PuglStatus nothing (View&, const PuglAnyEvent&) { return PUGL_SUCCESS; }
 
+    /** Fill a record from a pugl event. Returns false for events that
+        aren't input, like exposes, which replay regenerates on its own.
+     */
+    static bool to_record (const PuglEvent& ev, InputRecord& r) noexcept {
+        r       = {};
+        r.flags = static_cast<uint8_t> (ev.any.flags);
+
+        auto pointer = [&r] (const auto& pev) {
+            r.x     = static_cast<float> (pev.x);
+            r.y     = static_cast<float> (pev.y);
+            r.state = pev.state;
+        };
+
+        switch (ev.type) {
+            case PUGL_CONFIGURE:
+                r.type = InputRecord::CONFIGURE;
+                r.x    = static_cast<float> (ev.configure.x);
+                r.y    = static_cast<float> (ev.configure.y);
+                r.dx   = static_cast<float> (ev.configure.width);
+                r.dy   = static_cast<float> (ev.configure.height);
+                r.code = ev.configure.style;
+                break;
+            case PUGL_UPDATE:
+                r.type = InputRecord::UPDATE;
+                break;
+            case PUGL_TIMER:
+                r.type = InputRecord::TIMER;
+                r.code = static_cast<uint32_t> (ev.timer.id);
+                break;
+            case PUGL_FOCUS_IN:
+            case PUGL_FOCUS_OUT:
+                r.type = ev.type == PUGL_FOCUS_IN ? InputRecord::FOCUS_IN : InputRecord::FOCUS_OUT;
+                r.code = ev.focus.mode;
+                break;
+            case PUGL_KEY_PRESS:
+            case PUGL_KEY_RELEASE:
+                r.type = ev.type == PUGL_KEY_PRESS ? InputRecord::KEY_PRESS : InputRecord::KEY_RELEASE;
+                pointer (ev.key);
+                r.code    = ev.key.key;
+                r.keycode = ev.key.keycode;
+                break;
+            case PUGL_TEXT:
+                r.type = InputRecord::TEXT;
+                pointer (ev.text);
+                r.code    = ev.text.character;
+                r.keycode = ev.text.keycode;
+                std::memcpy (r.text, ev.text.string, sizeof (r.text));
+                break;
+            case PUGL_POINTER_IN:
+            case PUGL_POINTER_OUT:
+                r.type = ev.type == PUGL_POINTER_IN ? InputRecord::POINTER_IN : InputRecord::POINTER_OUT;
+                pointer (ev.crossing);
+                r.code = ev.crossing.mode;
+                break;
+            case PUGL_BUTTON_PRESS:
+            case PUGL_BUTTON_RELEASE:
+                r.type = ev.type == PUGL_BUTTON_PRESS ? InputRecord::BUTTON_PRESS : InputRecord::BUTTON_RELEASE;
+                pointer (ev.button);
+                r.code = ev.button.button;
+                break;
+            case PUGL_MOTION:
+                r.type = InputRecord::MOTION;
+                pointer (ev.motion);
+                break;
+            case PUGL_SCROLL:
+                r.type = InputRecord::SCROLL;
+                pointer (ev.scroll);
+                r.code = ev.scroll.direction;
+                r.dx   = static_cast<float> (ev.scroll.dx);
+                r.dy   = static_cast<float> (ev.scroll.dy);
+                break;
+            default:
+                return false;
+        }
+
+        return true;
+    }
+
+    /** Rebuild a pugl event from a record. */
+    static bool from_record (const InputRecord& r, PuglEvent& ev) noexcept {
+        std::memset (&ev, 0, sizeof (ev));
+        ev.any.flags = r.flags;
+
+        auto pointer = [&r] (auto& pev) {
+            pev.time  = r.time;
+            pev.x     = r.x;
+            pev.y     = r.y;
+            pev.state = r.state;
+        };
+
+        switch (r.type) {
+            case InputRecord::CONFIGURE:
+                ev.type             = PUGL_CONFIGURE;
+                ev.configure.x      = static_cast<PuglCoord> (r.x);
+                ev.configure.y      = static_cast<PuglCoord> (r.y);
+                ev.configure.width  = static_cast<PuglSpan> (r.dx);
+                ev.configure.height = static_cast<PuglSpan> (r.dy);
+                ev.configure.style  = r.code;
+                break;
+            case InputRecord::UPDATE:
+                ev.type = PUGL_UPDATE;
+                break;
+            case InputRecord::TIMER:
+                ev.type     = PUGL_TIMER;
+                ev.timer.id = r.code;
+                break;
+            case InputRecord::FOCUS_IN:
+            case InputRecord::FOCUS_OUT:
+                ev.type       = r.type == InputRecord::FOCUS_IN ? PUGL_FOCUS_IN : PUGL_FOCUS_OUT;
+                ev.focus.mode = static_cast<PuglCrossingMode> (r.code);
+                break;
+            case InputRecord::KEY_PRESS:
+            case InputRecord::KEY_RELEASE:
+                ev.type = r.type == InputRecord::KEY_PRESS ? PUGL_KEY_PRESS : PUGL_KEY_RELEASE;
+                pointer (ev.key);
+                ev.key.key     = r.code;
+                ev.key.keycode = r.keycode;
+                break;
+            case InputRecord::TEXT:
+                ev.type = PUGL_TEXT;
+                pointer (ev.text);
+                ev.text.character = r.code;
+                ev.text.keycode   = r.keycode;
+                std::memcpy (ev.text.string, r.text, sizeof (ev.text.string));
+                break;
+            case InputRecord::POINTER_IN:
+            case InputRecord::POINTER_OUT:
+                ev.type = r.type == InputRecord::POINTER_IN ? PUGL_POINTER_IN : PUGL_POINTER_OUT;
+                pointer (ev.crossing);
+                ev.crossing.mode = static_cast<PuglCrossingMode> (r.code);
+                break;
+            case InputRecord::BUTTON_PRESS:
+            case InputRecord::BUTTON_RELEASE:
+                ev.type = r.type == InputRecord::BUTTON_PRESS ? PUGL_BUTTON_PRESS : PUGL_BUTTON_RELEASE;
+                pointer (ev.button);
+                ev.button.button = r.code;
+                break;
+            case InputRecord::MOTION:
+                ev.type = PUGL_MOTION;
+                pointer (ev.motion);
+                break;
+            case InputRecord::SCROLL:
+                ev.type = PUGL_SCROLL;
+                pointer (ev.scroll);
+                ev.scroll.direction = static_cast<PuglScrollDirection> (r.code);
+                ev.scroll.dx        = r.dx;
+                ev.scroll.dy        = r.dy;
+                break;
+            default:
+                return false;
+        }
+
+        return true;
+    }
+
     static inline PuglStatus dispatch (PuglView* v, const PuglEvent* ev) {
         auto view         = static_cast<View*> (puglGetHandle (v));
         PuglStatus status = PUGL_SUCCESS;
 
+        if (view->recorder != nullptr) {
+            InputRecord record;
+            if (to_record (*ev, record))
+                view->recorder->write (record);
+        }
+
+        // Motion is held until the frame update. Anything else that arrives
+        // first sees the pointer where it really is.
+        if (ev->type != PUGL_MOTION)
+            view->flush_motion();
+
+        if (view->latency.enabled()) {
+            switch (ev->type) {
+                case PUGL_KEY_PRESS:
+                case PUGL_KEY_RELEASE:
+                case PUGL_TEXT:
+                case PUGL_BUTTON_PRESS:
+                case PUGL_BUTTON_RELEASE:
+                case PUGL_SCROLL:
+                    view->latency.set_input (view->now());
+                    break;
+                default:
+                    break;
+            }
+        }
+
 #define CASE3(t, fn, arg)         \
     case t:                       \
         status = fn (*view, arg); \
@@ -736,6 +1185,7 @@ private:
 #undef CASE2
 #undef CASE3
 #undef CASEA
+        view->latency.set_input (-1.0);
         return status;
     }
 };
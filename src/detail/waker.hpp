@@ -0,0 +1,47 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include <lui/lui.h>
+
+namespace lui {
+namespace detail {
+
+/** Runs a function on its own thread when signalled from any other.
+
+    Signalling writes a byte to a pipe, or sets an event on Windows: one
+    system call and no locks in user space, so realtime threads can use it.
+    The waker thread does the rest, like sending pugl the event that wakes
+    the loop, which takes the display lock and flushes on X11.
+ */
+class Waker {
+public:
+    explicit Waker (std::function<void()> fn);
+    ~Waker();
+
+    /** Run the function soon on the waker thread. Any thread. Signals
+        arriving before it runs are merged.
+     */
+    void wake() noexcept;
+
+private:
+    std::function<void()> fn;
+    std::atomic<bool> quit { false };
+#ifdef _WIN32
+    void* event { nullptr };
+#else
+    int fds[2] { -1, -1 };
+#endif
+    std::thread thread;
+
+    void run();
+    LUI_DISABLE_COPY (Waker)
+};
+
+} // namespace detail
+} // namespace lui
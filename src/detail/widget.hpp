@@ -3,11 +3,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <vector>
 
 #include <lui/point.hpp>
 #include <lui/rectangle.hpp>
 
+#include "detail/pool.hpp"
+#include "detail/render_list.hpp"
+
 // =================== widget debugging =======================//
 #define DBG_WIDGET 0
 #if DBG_WIDGET
@@ -33,7 +39,7 @@ static Point<float> to_unscaled (float scale, Point<float> coord) {
 }
 #endif
 
-static Point<float> from_parent_space (const Widget& widget, const Point<float> parent_coord) {
+inline Point<float> from_parent_space (const Widget& widget, const Point<float> parent_coord) {
     auto result = parent_coord;
     if (widget.elevated())
         return result;
@@ -41,15 +47,7 @@ static Point<float> from_parent_space (const Widget& widget, const Point<float>
     return result;
 }
 
-static Point<float> from_ancestor_space (const Widget* parent, const Widget& target, Point<float> parent_coord) {
-    auto direct = target.parent();
-    if (direct == parent)
-        return from_parent_space (target, parent_coord);
-
-    return from_parent_space (target, from_ancestor_space (parent, *direct, parent_coord));
-}
-
-static Point<float> to_parent_space (const Widget& widget,
+inline Point<float> to_parent_space (const Widget& widget,
                                      const Point<float> local_coord) {
     auto result = local_coord;
     if (widget.elevated())
@@ -58,30 +56,6 @@ static Point<float> to_parent_space (const Widget& widget,
     return result;
 }
 
-static inline Point<float> coordinate (const Widget* tgt, const Widget* src, Point<float> pt) {
-    while (src != nullptr) {
-        if (src == tgt)
-            return pt;
-
-        if (tgt != nullptr && src->contains (*tgt, true))
-            return from_ancestor_space (src, *tgt, pt);
-
-        pt  = to_parent_space (*src, pt);
-        src = src->parent();
-    }
-
-    assert (src == nullptr);
-    if (tgt == nullptr)
-        return pt;
-
-    auto root = tgt->find_root();
-    pt        = from_parent_space (*root, pt);
-    if (root == tgt)
-        return pt;
-
-    return from_ancestor_space (root, *tgt, pt);
-}
-
 } // namespace convert
 
 namespace detail {
@@ -104,6 +78,8 @@ public:
     Widget (lui::Widget& o) : owner (o) {}
     ~Widget() {}
 
+    LUI_POOL_ALLOCATED
+
     void grab_focus();
     void release_focus();
 
@@ -114,27 +90,162 @@ public:
     void notify_children_changed();
     void notify_moved_resized (bool was_moved, bool was_resized);
 
+    /** Updates a widget has queued in a Widget::UpdateBatch. */
+    enum Pending : uint8_t {
+        STRUCTURE = 1 << 0, ///< parent_structure_changed for the subtree
+        CHILDREN  = 1 << 1, ///< children_changed
+        MOVED     = 1 << 2, ///< moved
+        RESIZED   = 1 << 3, ///< resized and size notifications
+        REPAINT   = 1 << 4, ///< repaint the widget
+        DAMAGE    = 1 << 5  ///< repaint pending_damage
+    };
+
+    /** Open batches and the widgets they queued, per thread. */
+    struct Batch {
+        int depth { 0 };
+        std::vector<WidgetRef> widgets;
+    };
+
+    static Batch& batch() noexcept {
+        thread_local Batch b;
+        return b;
+    }
+
+    static bool batching() noexcept { return batch().depth > 0; }
+
+    /** Queue updates if a batch is open. Returns false if not. */
+    bool defer (uint8_t flags) {
+        auto& b = batch();
+        if (b.depth <= 0)
+            return false;
+        if (flags != 0 && pending == 0)
+            b.widgets.push_back (&owner);
+        pending |= flags;
+        return true;
+    }
+
+    /** Queue a repaint of an area in local coordinates. */
+    void defer_damage (Bounds area) {
+        if (area.empty())
+            return;
+        if ((pending & DAMAGE) == 0) {
+            pending_damage = area;
+        } else {
+            const auto x1  = std::min (pending_damage.x, area.x);
+            const auto y1  = std::min (pending_damage.y, area.y);
+            const auto x2  = std::max (pending_damage.x + pending_damage.width, area.x + area.width);
+            const auto y2  = std::max (pending_damage.y + pending_damage.height, area.y + area.height);
+            pending_damage = { x1, y1, x2 - x1, y2 - y1 };
+        }
+        defer (DAMAGE);
+    }
+
+    /** Dispatch everything queued, until nothing more is. */
+    static void commit_batch();
+
+    /** Children in paint order, back to front. Removing a child leaves a
+        null hole in `widgets` so it costs O(1); holes are squeezed out
+        here. Loops that may see a removal while running must skip nulls.
+     */
+    std::vector<lui::Widget*>& children() {
+        if (holes > 0)
+            compact();
+        return widgets;
+    }
+
+    /** Number of children, not counting holes. */
+    size_t num_children() const noexcept { return widgets.size() - holes; }
+
+    /** Insert a child in front of the siblings with its z order or lower. */
+    void insert_child (lui::Widget* child);
+
+    /** Remove a child, leaving a hole. Returns false if not a child. */
+    bool erase_child (lui::Widget* child);
+
+    /** Move a child to the front or back of its z order. */
+    void restack_child (lui::Widget* child, bool front);
+
+    /** Remove holes and renumber the children. */
+    void compact();
+
+    /** Add the memory held by root and everything under it to stats. */
+    static void add_memory_stats (const lui::Widget& root, MemoryStats& stats) noexcept;
+
+    /** Drop the render lists of root and everything under it. They are
+        built again by the next render.
+     */
+    static void trim_render_lists (lui::Widget& root) noexcept;
+
+    /** The widget's origin in the coordinate space of its root, usually the
+        view. Cached until the tree generation changes and parents are cached
+        along the way, so this is O(1) between layout changes.
+     */
+    static Point<float> absolute_offset (const lui::Widget& w) noexcept {
+        auto& impl = *w.impl;
+        if (impl.offset_generation != generation()) {
+            impl.offset = impl.view != nullptr ? Point<float>() : impl.bounds.pos().as<float>();
+            if (impl.parent != nullptr)
+                impl.offset += absolute_offset (*impl.parent);
+            impl.offset_generation = generation();
+        }
+        return impl.offset;
+    }
+
 private:
     friend class lui::Widget;
     friend class lui::Main;
     friend class detail::Main;
     friend class lui::View;
     friend class detail::View;
+    friend class detail::RenderList;
 
     lui::Widget& owner;
     std::string name;
     lui::Widget* parent = nullptr;
     std::unique_ptr<lui::View> view;
     std::vector<lui::Widget*> widgets;
+    uint32_t holes { 0 }; // null entries in widgets
+    uint32_t index { 0 }; // position in the parent's widgets
+    int z_order { 0 };
+    uint64_t style_uses { 0 }; // style entries read by the last paint
     Rectangle<int> bounds;
     bool visible { false };
     bool opaque { false };
     bool dont_clip { false };
 
-    static bool clip_widgets_blocking (const lui::Widget& w, Graphics& g, const Rectangle<int> cr, Point<int> delta);
-    static void render_child (lui::Widget& cw, Graphics& g);
-    static void render_all (lui::Widget& widget, Graphics& g);
+    /** Bumped whenever a widget is added, removed, moved, resized, shown,
+        hidden or made opaque anywhere. Views use it to know when cached hit
+        tests are stale, and render lists when to flatten the tree again.
+        Every thread counts its own, like the widget handle table.
+     */
+    static uint64_t& generation() noexcept;
+
+    Point<float> offset;
+    uint64_t offset_generation { ~uint64_t (0) };
+
+    uint8_t pending { 0 };
+    uint8_t dispatching { 0 };
+    Bounds pending_damage;
+
+    std::unique_ptr<RenderList> render_list;
 };
 
 } // namespace detail
+
+namespace convert {
+
+/** Convert pt from src's space to tgt's. A null src or tgt means the space
+    of the root.
+ */
+static inline Point<float> coordinate (const Widget* tgt, const Widget* src, Point<float> pt) {
+    if (src == tgt)
+        return pt;
+    if (src != nullptr)
+        pt += detail::Widget::absolute_offset (*src);
+    if (tgt != nullptr)
+        pt -= detail::Widget::absolute_offset (*tgt);
+    return pt;
+}
+
+} // namespace convert
 } // namespace lui
@@ -1,92 +1,147 @@
 // Copyright 2022 Kushview, LLC
 // SPDX-License-Identifier: ISC
 
+#include <algorithm>
 #include <iostream>
 
 #include <lui/entry.hpp>
 
+#include "detail/pool.hpp"
 #include "detail/pugl.hpp"
+#include "detail/text_line.hpp"
 
 namespace lui {
 namespace detail {
 class Entry {
 public:
-    Entry (lui::Entry& o) : owner (o) {}
+    Entry (lui::Entry& o) : owner (o) {
+        font = font.with_height (15.f);
+    }
+
+    LUI_POOL_ALLOCATED
 
     void paint (Graphics& g) {
         g.set_color (0xff000000);
         g.fill_rect (owner.bounds().at (0));
 
-        auto bounds = owner.bounds().at (0).smaller (2).as<float>();
+        auto bounds = text_area().as<float>();
 
         g.set_color (0xffffffff);
-        font = font.with_height (15.f);
         g.set_font (font);
+        if (measured_height != font.height()) {
+            line.invalidate();
+            measured_height = font.height();
+        }
+        line.layout (g.context());
 
         const auto fm = g.context().font_metrics();
         auto text_y   = bounds.y + (bounds.height - static_cast<float> (fm.height)) * 0.5f;
-        g.draw_text (current_text, Rectangle<float> { bounds.x, text_y, bounds.width, static_cast<float> (fm.height) }, Justify::TOP_LEFT);
+        g.draw_text (line.text(), Rectangle<float> { bounds.x, text_y, bounds.width, static_cast<float> (fm.height) }, Justify::TOP_LEFT);
 
         // Draw caret
         if (owner.focused()) {
-            const auto tm = g.context().text_metrics (current_text.substr (0, cursor));
-
-            auto caret_x      = bounds.x + static_cast<float> (tm.width) + 2.f;
+            auto caret_x      = bounds.x + line.x_of (line.caret());
             auto caret_height = static_cast<float> (fm.height);
             auto caret_y      = text_y;
 
             g.set_color (0xffffffff);
-            g.fill_rect (Rectangle<float> { caret_x, caret_y, 2.f, caret_height });
+            g.fill_rect (Rectangle<float> { caret_x, caret_y, caret_width, caret_height });
         }
     }
 
     bool key_down (const KeyEvent& ev) {
-        if (ev.key() == PUGL_KEY_BACKSPACE) {
-            handle_backspace();
-            owner.repaint();
-            return true;
-        } else if (ev.key() == PUGL_KEY_DELETE) {
-            handle_delete();
-            owner.repaint();
-            return true;
+        switch (ev.key()) {
+            case PUGL_KEY_BACKSPACE:
+                handle_backspace();
+                return true;
+            case PUGL_KEY_DELETE:
+                handle_delete();
+                return true;
+            case PUGL_KEY_LEFT:
+                move_cursor (line.prev (line.caret()));
+                return true;
+            case PUGL_KEY_RIGHT:
+                move_cursor (line.next (line.caret()));
+                return true;
+            case PUGL_KEY_HOME:
+                move_cursor (0);
+                return true;
+            case PUGL_KEY_END:
+                move_cursor (line.size());
+                return true;
         }
         return false;
     }
 
     bool text_entry (const TextEvent& ev) {
-        auto osize = current_text.size();
+        const auto pos = line.caret();
+        if (line.insert (ev.body))
+            repaint_from (pos);
+        return true;
+    }
 
-        for (const auto c : ev.body) {
-            if (c >= ' ' && c <= '~') {
-                current_text += c;
-            }
+    void pressed (const Event& ev) {
+        const auto pos = line.hit (ev.pos.x - static_cast<float> (text_area().x));
+        if (pos == line.caret()) {
+            // focus may have just arrived, show the caret where it is.
+            const auto x = line.x_of (pos);
+            repaint_span (x, x);
+            return;
         }
-
-        cursor = current_text.size();
-
-        if (osize != current_text.size())
-            owner.repaint();
-        return true;
+        move_cursor (pos);
     }
 
     void handle_delete() {
-        if (current_text.size() > cursor)
-            current_text.erase (cursor, 1);
+        const auto pos = line.caret();
+        if (pos < line.size()) {
+            repaint_from (pos);
+            line.erase (pos);
+        }
     }
 
     void handle_backspace() {
-        if (cursor > 0 && ! current_text.empty()) {
-            --cursor;
-            current_text.erase (cursor, 1);
+        const auto pos = line.caret();
+        if (pos > 0) {
+            const auto prev = line.prev (pos);
+            repaint_from (prev);
+            line.erase (prev);
         }
     }
 
 private:
     friend class lui::Entry;
     lui::Entry& owner;
-    std::string current_text;
-    uint32_t cursor = 0;
     lui::Font font;
+    TextLine line;
+    float measured_height { 0.f };
+
+    static constexpr float caret_width = 2.f;
+
+    Bounds text_area() const noexcept { return owner.bounds().at (0).smaller (2); }
+
+    void repaint_span (float x1, float x2) {
+        const auto area  = text_area();
+        const auto left  = area.x + static_cast<int> (std::min (x1, x2)) - 1;
+        const auto right = area.x + static_cast<int> (std::max (x1, x2) + caret_width) + 1;
+        owner.repaint ({ left, 0, right - left, owner.height() });
+    }
+
+    /** Repaint from a caret position to the right edge. Starts one
+        character early, kerning with the edit can move it.
+     */
+    void repaint_from (size_t pos) {
+        const auto area = text_area();
+        const auto left = area.x + static_cast<int> (line.x_of (line.prev (pos))) - 1;
+        owner.repaint ({ left, 0, owner.width() - left, owner.height() });
+    }
+
+    void move_cursor (size_t pos) {
+        if (pos == line.caret())
+            return;
+        const auto x1 = line.x_of (line.caret());
+        line.set_caret (pos);
+        repaint_span (x1, line.x_of (line.caret()));
+    }
 };
 
 } // namespace detail
@@ -96,7 +151,7 @@ Entry::~Entry() { impl.reset(); }
 
 void Entry::pressed (const Event& ev) {
     grab_focus();
-    repaint();
+    impl->pressed (ev);
 }
 
 void Entry::paint (Graphics& g) { impl->paint (g); }
@@ -1,28 +1,109 @@
 // Copyright 2022 Kushview, LLC
 // SPDX-License-Identifier: ISC
 
+#include <fstream>
+#include <unordered_map>
+
 #include <lui/font.hpp>
 
+#include "detail/gap_buffer.hpp"
+#include "detail/glyph_coverage.hpp"
+
 namespace lui {
 namespace detail {
 
 static constexpr float default_height = 15.f;
 
+/** Typeface backed by a copy of a font file. */
+class MemoryTypeface final : public lui::Typeface {
+public:
+    MemoryTypeface (std::string n, std::vector<uint8_t> d)
+        : _name (std::move (n)), _data (std::move (d)) {}
+    std::string name() const noexcept override { return _name; }
+    const uint8_t* data() const noexcept override { return _data.data(); }
+    size_t size() const noexcept override { return _data.size(); }
+
+private:
+    std::string _name;
+    std::vector<uint8_t> _data;
+};
+
+class FontFallback {
+public:
+    std::vector<TypefacePtr> faces;
+
+    int resolve (uint32_t c) const noexcept {
+        for (size_t i = 0; i < faces.size(); ++i)
+            if (faces[i]->has_glyph (c))
+                return static_cast<int> (i);
+        return -1;
+    }
+
+    const std::vector<lui::FontFallback::Run>& runs (std::string_view text) {
+        lookup.assign (text.data(), text.size());
+        if (auto it = cache.find (lookup); it != cache.end())
+            return it->second;
+
+        if (cache.size() >= max_cached)
+            cache.clear();
+
+        std::vector<lui::FontFallback::Run> result;
+        for (size_t i = 0; i < text.size();) {
+            const auto len = std::max (uint32_t (1), utf8::sequence_length (static_cast<uint8_t> (text[i])));
+            const auto cp  = len <= text.size() - i ? decode (text.data() + i, len) : 0xFFFD;
+            const auto n   = std::min (size_t (len), text.size() - i);
+            const auto fi  = resolve (cp);
+
+            if (! result.empty() && result.back().face == fi)
+                result.back().length += static_cast<uint32_t> (n);
+            else
+                result.push_back ({ static_cast<uint32_t> (i), static_cast<uint32_t> (n), fi });
+            i += n;
+        }
+
+        return cache.emplace (lookup, std::move (result)).first->second;
+    }
+
+    void clear_cache() noexcept { cache.clear(); }
+
+private:
+    static constexpr size_t max_cached = 256;
+    std::unordered_map<std::string, std::vector<lui::FontFallback::Run>> cache;
+    std::string lookup;
+
+    static uint32_t decode (const char* s, uint32_t len) noexcept {
+        const auto b = reinterpret_cast<const uint8_t*> (s);
+        switch (len) {
+            case 1:
+                return b[0];
+            case 2:
+                return ((b[0] & 0x1Fu) << 6) | (b[1] & 0x3Fu);
+            case 3:
+                return ((b[0] & 0x0Fu) << 12) | ((b[1] & 0x3Fu) << 6) | (b[2] & 0x3Fu);
+            case 4:
+                return ((b[0] & 0x07u) << 18) | ((b[1] & 0x3Fu) << 12) | ((b[2] & 0x3Fu) << 6) | (b[3] & 0x3Fu);
+        }
+        return 0xFFFD;
+    }
+};
+
 class Font {
 public:
     Font() {}
     float height { default_height };
     uint8_t flags { lui::Font::NORMAL };
     std::shared_ptr<Typeface> face;
+    std::shared_ptr<FontFallback> fallback;
     Font (const Font& o) { operator= (o); }
     Font& operator= (const Font& o) {
-        height = o.height;
-        flags  = o.flags;
-        face   = o.face;
+        height   = o.height;
+        flags    = o.flags;
+        face     = o.face;
+        fallback = o.fallback;
         return *this;
     }
     bool operator== (const Font& o) const noexcept {
-        return height == o.height && flags == o.flags && face == o.face;
+        return height == o.height && flags == o.flags && face == o.face && fallback == o.fallback;
     }
     bool operator!= (const Font& o) const noexcept {
         return ! operator== (o);
@@ -31,6 +112,71 @@ public:
 
 } // namespace detail
 
+Typeface::Typeface()  = default;
+Typeface::~Typeface() = default;
+
+bool Typeface::has_glyph (uint32_t codepoint) const noexcept {
+    if (_coverage == nullptr) {
+        auto cov = std::make_unique<detail::GlyphCoverage>();
+        if (data() != nullptr && size() > 0)
+            *cov = detail::GlyphCoverage::from_font (data(), size());
+        _coverage = std::move (cov);
+    }
+    return _coverage->contains (codepoint);
+}
+
+TypefacePtr Typeface::load (const std::string& path) {
+    std::ifstream stream (path, std::ios::binary | std::ios::ate);
+    if (! stream.is_open())
+        return nullptr;
+
+    const auto length = stream.tellg();
+    if (length <= 0)
+        return nullptr;
+
+    std::vector<uint8_t> data (static_cast<size_t> (length));
+    stream.seekg (0);
+    if (! stream.read (reinterpret_cast<char*> (data.data()), length))
+        return nullptr;
+
+    auto name = path.substr (path.find_last_of ("/\\") + 1);
+    return std::make_shared<detail::MemoryTypeface> (std::move (name), std::move (data));
+}
+
+FontFallback::FontFallback() : impl (std::make_shared<detail::FontFallback>()) {}
+FontFallback::~FontFallback() = default;
+
+void FontFallback::add (TypefacePtr face) {
+    if (face == nullptr)
+        return;
+    if (impl == nullptr)
+        impl = std::make_shared<detail::FontFallback>();
+    impl->faces.push_back (std::move (face));
+    impl->clear_cache();
+}
+
+size_t FontFallback::size() const noexcept { return impl != nullptr ? impl->faces.size() : 0; }
+bool FontFallback::empty() const noexcept { return size() == 0; }
+TypefacePtr FontFallback::face (size_t index) const noexcept {
+    return index < size() ? impl->faces[index] : nullptr;
+}
+
+int FontFallback::resolve (uint32_t codepoint) const noexcept {
+    return impl != nullptr ? impl->resolve (codepoint) : -1;
+}
+
+const std::vector<FontFallback::Run>& FontFallback::runs (std::string_view text) const {
+    if (impl != nullptr)
+        return impl->runs (text);
+
+    // no faces, the whole text is unresolved.
+    static thread_local std::vector<Run> none;
+    none.clear();
+    if (! text.empty())
+        none.push_back ({ 0, static_cast<uint32_t> (text.size()), -1 });
+    return none;
+}
+
 Font::Font() : impl (std::make_shared<detail::Font>()) {}
 
 Font::Font (float height) : impl (std::make_shared<detail::Font>()) {
@@ -81,6 +227,15 @@ Font Font::with_height (float height) const noexcept {
     return f;
 }
 
+FontFallback Font::fallback() const noexcept { return FontFallback (impl->fallback); }
+
+Font Font::with_fallback (const FontFallback& fallback) const noexcept {
+    Font f;
+    *f.impl          = *impl;
+    f.impl->fallback = fallback.impl;
+    return f;
+}
+
 bool Font::operator== (const Font& o) const noexcept {
     return impl == o.impl || *impl == *o.impl;
 }
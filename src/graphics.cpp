@@ -8,10 +8,48 @@
 
 namespace lui {
 
+/** Replace the context's path with path. */
+template <class Pth>
+static void add_path (DrawingContext& dc, const Pth& path) {
+    dc.clear_path();
+
+    for (const auto& i : path) {
+        switch (i.type) {
+            case PathOp::MOVE:
+                dc.move_to (i.x1, i.y1);
+                break;
+            case PathOp::LINE:
+                dc.line_to (i.x1, i.y1);
+                break;
+            case PathOp::QUADRATIC:
+                dc.quad_to (i.x1, i.y1, i.x2, i.y2);
+                break;
+            case PathOp::CUBIC:
+                dc.cubic_to (i.x1, i.y1, i.x2, i.y2, i.x3, i.y3);
+                break;
+            case PathOp::CLOSE:
+                dc.close_path();
+                break;
+        }
+    }
+}
+
+void DrawingContext::text_positions (std::string_view text, std::vector<float>& xs) const {
+    xs.clear();
+    for (size_t i = 0; i < text.size(); ++i)
+        if ((static_cast<uint8_t> (text[i]) & 0xC0) != 0x80)
+            xs.push_back (i == 0 ? 0.f : static_cast<float> (text_metrics (text.substr (0, i)).x_stride));
+    xs.push_back (static_cast<float> (text_metrics (text).x_stride));
+}
+
 Graphics::Graphics (DrawingContext& d)
-    : _context (d) {}
+    : Graphics (d, FrameArena::current()) {}
+
+Graphics::Graphics (DrawingContext& d, FrameArena& arena)
+    : _context (d), _arena (arena) {}
 
 DrawingContext& Graphics::context() { return _context; }
+FrameArena& Graphics::frame_arena() noexcept { return _arena; }
 
 void Graphics::translate (Point<int> delta) {
     _context.translate (delta.x, delta.y);
@@ -31,28 +69,12 @@ void Graphics::set_font (double height) { set_font (Font (static_cast<float> (he
 void Graphics::set_color (Color color) { _context.set_fill (color); }
 
 void Graphics::fill_path (const Path& path) {
-    _context.clear_path();
-
-    for (const auto& i : path) {
-        switch (i.type) {
-            case PathOp::MOVE:
-                _context.move_to (i.x1, i.y1);
-                break;
-            case PathOp::LINE:
-                _context.line_to (i.x1, i.y1);
-                break;
-            case PathOp::QUADRATIC:
-                _context.quad_to (i.x1, i.y1, i.x2, i.y2);
-                break;
-            case PathOp::CUBIC:
-                _context.cubic_to (i.x1, i.y1, i.x2, i.y2, i.x3, i.y3);
-                break;
-            case PathOp::CLOSE:
-                _context.close_path();
-                break;
-        }
-    }
+    add_path (_context, path);
+    _context.fill();
+}
 
+void Graphics::fill_path (const FramePath& path) {
+    add_path (_context, path);
     _context.fill();
 }
 
@@ -115,27 +137,12 @@ void Graphics::fill_rounded_rect (const Rectangle<float>& r, float corner_size)
 }
 
 void Graphics::stroke_path (const Path& path) {
-    _context.clear_path();
+    add_path (_context, path);
+    _context.stroke();
+}
 
-    for (const auto& i : path) {
-        switch (i.type) {
-            case PathOp::MOVE:
-                _context.move_to (i.x1, i.y1);
-                break;
-            case PathOp::LINE:
-                _context.line_to (i.x1, i.y1);
-                break;
-            case PathOp::QUADRATIC:
-                _context.quad_to (i.x1, i.y1, i.x2, i.y2);
-                break;
-            case PathOp::CUBIC:
-                _context.cubic_to (i.x1, i.y1, i.x2, i.y2, i.x3, i.y3);
-                break;
-            case PathOp::CLOSE:
-                _context.close_path();
-                break;
-        }
-    }
+void Graphics::stroke_path (const FramePath& path) {
+    add_path (_context, path);
     _context.stroke();
 }
 
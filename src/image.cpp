@@ -34,6 +34,10 @@ bool Image::valid() const noexcept {
     return _pixels != nullptr;
 }
 
+size_t Image::total_bytes() noexcept {
+    return stb::Pixels::live_bytes().load();
+}
+
 } // namespace lui
 
 #include "stb/image.ipp"
@@ -0,0 +1,407 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <algorithm>
+#include <cmath>
+
+#include <lui/layout.hpp>
+
+namespace lui {
+namespace detail {
+
+class Layout {
+public:
+    /** Sizes remembered per layout. */
+    static constexpr size_t max_cached = 4;
+
+    Layout (lui::Layout& o) : owner (o) { cache.reserve (max_cached); }
+
+    const std::vector<Bounds>& solve (int width, int height) {
+        for (auto& entry : cache)
+            if (entry.width == width && entry.height == height)
+                return entry.bounds;
+
+        if (cache.size() < max_cached)
+            cache.push_back ({});
+        auto& entry  = cache[next_slot];
+        next_slot    = (next_slot + 1) % max_cached;
+        entry.width  = width;
+        entry.height = height;
+        entry.bounds.assign (owner.item_count(), {});
+        owner.compute (Bounds (0, 0, width, height).reduced (padding), entry.bounds);
+        return entry.bounds;
+    }
+
+    void invalidate() noexcept {
+        cache.clear();
+        next_slot = 0;
+    }
+
+    /** Set every item's bounds in one update batch. */
+    void apply() {
+        if (applying) {
+            reapply = true;
+            return;
+        }
+
+        lui::Widget::UpdateBatch batch;
+        applying = true;
+        do {
+            reapply = false;
+            applied = solve (owner.width(), owner.height());
+            for (size_t i = 0; i < applied.size() && i < owner.item_count(); ++i)
+                if (auto widget = owner.item_widget (i); widget != nullptr && widget->visible())
+                    widget->set_bounds (applied[i]);
+        } while (reapply);
+        applying = false;
+    }
+
+    /** Drop items whose widgets were removed. */
+    void prune() {
+        for (size_t i = owner.item_count(); i-- > 0;) {
+            auto widget = owner.item_widget (i);
+            if (widget == nullptr || widget->parent() != &owner)
+                owner.erase_item (i);
+        }
+    }
+
+    /** Give children added without an item a default one. */
+    void adopt() {
+        for (size_t c = 0; c < owner.num_children(); ++c)
+            if (auto child = owner.child_at (c); child != nullptr && ! has_item (*child))
+                owner.append_item (*child);
+    }
+
+    bool has_item (const lui::Widget& widget) const noexcept {
+        for (size_t i = 0; i < owner.item_count(); ++i)
+            if (owner.item_widget (i) == &widget)
+                return true;
+        return false;
+    }
+
+private:
+    friend class lui::Layout;
+
+    struct Entry {
+        int width { 0 };
+        int height { 0 };
+        std::vector<Bounds> bounds;
+    };
+
+    lui::Layout& owner;
+    std::vector<Entry> cache;
+    size_t next_slot { 0 };
+    std::vector<Bounds> applied;
+    int padding { 0 };
+    int gap { 0 };
+    bool applying { false };
+    bool reapply { false };
+};
+
+/** Round accumulated float edges to whole pixels so items stay adjacent. */
+static inline int snap (float v) noexcept { return static_cast<int> (std::lround (v)); }
+
+} // namespace detail
+
+Layout::Layout() : impl (std::make_unique<detail::Layout> (*this)) {}
+Layout::~Layout() { impl.reset(); }
+
+void Layout::set_padding (int padding) {
+    padding = std::max (0, padding);
+    if (padding == impl->padding)
+        return;
+    impl->padding = padding;
+    invalidate();
+}
+
+int Layout::padding() const noexcept { return impl->padding; }
+
+void Layout::set_gap (int gap) {
+    gap = std::max (0, gap);
+    if (gap == impl->gap)
+        return;
+    impl->gap = gap;
+    invalidate();
+}
+
+int Layout::gap() const noexcept { return impl->gap; }
+size_t Layout::num_items() const noexcept { return item_count(); }
+
+const std::vector<Bounds>& Layout::solve (int width, int height) {
+    return impl->solve (width, height);
+}
+
+void Layout::invalidate() {
+    impl->invalidate();
+    impl->apply();
+}
+
+void Layout::resized() { impl->apply(); }
+
+void Layout::children_changed() {
+    impl->prune();
+    impl->adopt();
+    invalidate();
+}
+
+void Layout::child_visibility_changed (Widget* child) {
+    if (child != nullptr && impl->has_item (*child))
+        invalidate();
+}
+
+//==============================================================================
+FlexBox::FlexBox() {}
+FlexBox::~FlexBox() {}
+
+void FlexBox::add (Widget& widget, FlexItem item) {
+    if (set_item (widget, item))
+        return;
+    _items.push_back ({ &widget, item });
+    if (widget.parent() == this)
+        invalidate();
+    else
+        Widget::add (widget);
+}
+
+bool FlexBox::set_item (Widget& widget, FlexItem item) {
+    for (auto& entry : _items) {
+        if (entry.widget == &widget) {
+            entry.item = item;
+            invalidate();
+            return true;
+        }
+    }
+    return false;
+}
+
+void FlexBox::set_direction (Direction direction) {
+    if (direction == _direction)
+        return;
+    _direction = direction;
+    invalidate();
+}
+
+FlexBox::Direction FlexBox::direction() const noexcept { return _direction; }
+
+void FlexBox::set_justify (Justify justify) {
+    if (justify == _justify)
+        return;
+    _justify = justify;
+    invalidate();
+}
+
+void FlexBox::set_align (Align align) {
+    if (align == _align)
+        return;
+    _align = align;
+    invalidate();
+}
+
+Widget* FlexBox::item_widget (size_t index) const noexcept { return _items[index].widget; }
+void FlexBox::erase_item (size_t index) { _items.erase (_items.begin() + (ptrdiff_t) index); }
+void FlexBox::append_item (Widget& widget) { _items.push_back ({ &widget, {} }); }
+size_t FlexBox::item_count() const noexcept { return _items.size(); }
+
+void FlexBox::compute (Bounds area, std::vector<Bounds>& bounds) {
+    _shown.clear();
+    for (size_t i = 0; i < _items.size(); ++i)
+        if (_items[i].widget->visible())
+            _shown.push_back (i);
+
+    const auto count = _shown.size();
+    if (count == 0)
+        return;
+
+    const bool row        = _direction == ROW;
+    const float main_size = float (row ? area.width : area.height);
+    const int cross_size  = row ? area.height : area.width;
+    const float gaps      = float (gap() * int (count - 1));
+
+    _sizes.resize (count);
+    _frozen.assign (count, false);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& item = _items[_shown[i]].item;
+        _sizes[i]        = (float) std::clamp (item.basis, item.min_size, std::max (item.min_size, item.max_size));
+    }
+
+    // distribute free space by weight, freezing items that hit a limit
+    // and repeating with what is left. At most one round per item.
+    for (size_t round = 0; round < count; ++round) {
+        float used = gaps;
+        for (auto size : _sizes)
+            used += size;
+
+        const float free = main_size - used;
+        float weights    = 0.f;
+        for (size_t i = 0; i < count; ++i) {
+            const auto& item = _items[_shown[i]].item;
+            if (! _frozen[i])
+                weights += free > 0.f ? item.grow : item.shrink * float (std::max (1, item.basis));
+        }
+
+        if (std::abs (free) < 0.5f || weights <= 0.f)
+            break;
+
+        bool clamped = false;
+        for (size_t i = 0; i < count; ++i) {
+            if (_frozen[i])
+                continue;
+            const auto& item  = _items[_shown[i]].item;
+            const float share = free > 0.f ? item.grow : item.shrink * float (std::max (1, item.basis));
+            const float size  = _sizes[i] + free * share / weights;
+            const float limit = std::clamp (size, (float) item.min_size, (float) std::max (item.min_size, item.max_size));
+            if (limit != size) {
+                _frozen[i] = true;
+                clamped    = true;
+            }
+            _sizes[i] = limit;
+        }
+
+        if (! clamped)
+            break;
+    }
+
+    float used = gaps;
+    for (auto size : _sizes)
+        used += size;
+
+    const float free = std::max (0.f, main_size - used);
+    float position   = float (row ? area.x : area.y);
+    float spacing    = float (gap());
+    switch (_justify) {
+        case CENTER:
+            position += free * 0.5f;
+            break;
+        case END:
+            position += free;
+            break;
+        case SPACE_BETWEEN:
+            if (count > 1)
+                spacing += free / float (count - 1);
+            break;
+        case SPACE_AROUND:
+            spacing += free / float (count);
+            position += free / float (count) * 0.5f;
+            break;
+        case START:
+        default:
+            break;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto& item = _items[_shown[i]].item;
+        const int start  = detail::snap (position);
+        position += _sizes[i];
+        const int length = detail::snap (position) - start;
+        position += spacing;
+
+        const int cross = item.cross_size > 0 ? std::min (item.cross_size, cross_size) : cross_size;
+        int offset      = 0;
+        if (_align == ALIGN_CENTER)
+            offset = (cross_size - cross) / 2;
+        else if (_align == ALIGN_END)
+            offset = cross_size - cross;
+
+        bounds[_shown[i]] = row ? Bounds (start, area.y + offset, length, cross)
+                                : Bounds (area.x + offset, start, cross, length);
+    }
+}
+
+//==============================================================================
+Grid::Grid() {}
+Grid::~Grid() {}
+
+void Grid::set_columns (std::vector<GridTrack> columns) {
+    _columns = std::move (columns);
+    invalidate();
+}
+
+void Grid::set_rows (std::vector<GridTrack> rows) {
+    _rows = std::move (rows);
+    invalidate();
+}
+
+void Grid::add (Widget& widget, int column, int row, int column_span, int row_span) {
+    const Entry entry { &widget, column, row, std::max (1, column_span), std::max (1, row_span) };
+    auto it = std::find_if (_items.begin(), _items.end(), [&] (const Entry& e) { return e.widget == &widget; });
+    if (it != _items.end()) {
+        *it = entry;
+        invalidate();
+        return;
+    }
+
+    _items.push_back (entry);
+    if (widget.parent() == this)
+        invalidate();
+    else
+        Widget::add (widget);
+}
+
+Widget* Grid::item_widget (size_t index) const noexcept { return _items[index].widget; }
+void Grid::erase_item (size_t index) { _items.erase (_items.begin() + (ptrdiff_t) index); }
+
+void Grid::append_item (Widget& widget) {
+    int column = 0, row = 0;
+    if (! _items.empty()) {
+        const auto& last = _items.back();
+        column           = last.column + last.columns;
+        row              = last.row;
+        if (column >= (int) _columns.size()) {
+            column = 0;
+            row += last.rows;
+        }
+    }
+    _items.push_back ({ &widget, column, row, 1, 1 });
+}
+
+size_t Grid::item_count() const noexcept { return _items.size(); }
+
+/** Fill edges with the start and end of every track, start0 end0 start1... */
+static void grid_edges (const std::vector<GridTrack>& tracks, int start, int length, int gap, std::vector<int>& edges) {
+    edges.resize (tracks.size() * 2);
+    if (tracks.empty())
+        return;
+
+    float fixed = float (gap * int (tracks.size() - 1)), shares = 0.f;
+    for (const auto& t : tracks) {
+        if (t.fraction)
+            shares += std::max (0.f, t.size);
+        else
+            fixed += std::max (0.f, t.size);
+    }
+
+    const float left = std::max (0.f, float (length) - fixed);
+    float position   = float (start);
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        const auto& t   = tracks[i];
+        const auto size = t.fraction ? (shares > 0.f ? left * std::max (0.f, t.size) / shares : 0.f)
+                                     : std::max (0.f, t.size);
+        edges[i * 2]    = detail::snap (position);
+        position += size;
+        edges[i * 2 + 1] = detail::snap (position);
+        position += float (gap);
+    }
+}
+
+void Grid::compute (Bounds area, std::vector<Bounds>& bounds) {
+    grid_edges (_columns, area.x, area.width, gap(), _column_edges);
+    grid_edges (_rows, area.y, area.height, gap(), _row_edges);
+
+    const int ncols = (int) _columns.size();
+    const int nrows = (int) _rows.size();
+    for (size_t i = 0; i < _items.size(); ++i) {
+        const auto& e = _items[i];
+        if (! e.widget->visible() || e.column < 0 || e.row < 0 || e.column >= ncols || e.row >= nrows) {
+            bounds[i] = {};
+            continue;
+        }
+
+        const int last_col = std::min (ncols, e.column + e.columns) - 1;
+        const int last_row = std::min (nrows, e.row + e.rows) - 1;
+        const int x1       = _column_edges[e.column * 2];
+        const int y1       = _row_edges[e.row * 2];
+        bounds[i]          = { x1, y1, _column_edges[last_col * 2 + 1] - x1, _row_edges[last_row * 2 + 1] - y1 };
+    }
+}
+
+} // namespace lui
@@ -0,0 +1,191 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <algorithm>
+#include <cmath>
+
+#include <lui/list_view.hpp>
+
+#include "detail/pool.hpp"
+#include "detail/prefix_sum.hpp"
+
+namespace lui {
+namespace detail {
+
+class ListView {
+public:
+    ListView (lui::ListView& o) : owner (o) {}
+
+    LUI_POOL_ALLOCATED
+
+private:
+    friend class lui::ListView;
+    lui::ListView& owner;
+    ListModel* model { nullptr };
+    std::vector<int> heights;
+    PrefixSum<int> offsets;
+    int scroll { 0 };
+    int step { 24 };
+
+    struct Slot {
+        std::unique_ptr<lui::Widget> widget;
+        int row { -1 };
+    };
+    std::vector<Slot> slots;
+
+    int num_rows() const noexcept { return static_cast<int> (heights.size()); }
+
+    int row_at (int y) const noexcept {
+        if (y < 0 || y >= offsets.total())
+            return -1;
+        return static_cast<int> (offsets.find (y));
+    }
+
+    Slot* slot_for (int row) noexcept {
+        for (auto& slot : slots)
+            if (slot.row == row)
+                return &slot;
+        return nullptr;
+    }
+
+    /** Returns a slot not showing any row, creating one if needed. */
+    Slot* free_slot() {
+        for (auto& slot : slots)
+            if (slot.row < 0)
+                return &slot;
+
+        auto widget = model->create_row();
+        if (widget == nullptr)
+            return nullptr;
+        owner.add (*widget);
+        slots.push_back ({ std::move (widget), -1 });
+        return &slots.back();
+    }
+
+    void clamp_scroll() noexcept {
+        scroll = std::clamp (scroll, 0, std::max (0, offsets.total() - owner.height()));
+    }
+
+    /** Place a widget on every visible row. Rows already on screen keep their
+        widget; rows scrolling in reuse widgets from rows that scrolled out.
+     */
+    void layout (bool update_all) {
+        int first = -1, last = -2;
+        if (model != nullptr && owner.height() > 0) {
+            first = row_at (scroll);
+            last  = row_at (std::min (scroll + owner.height(), offsets.total()) - 1);
+        }
+
+        for (auto& slot : slots)
+            if (slot.row < first || slot.row > last)
+                slot.row = -1;
+
+        int top = first >= 0 ? offsets.sum (static_cast<size_t> (first)) : 0;
+        for (int row = first; row >= 0 && row <= last; ++row) {
+            auto slot        = slot_for (row);
+            const bool stale = slot == nullptr || update_all;
+            if (slot == nullptr && (slot = free_slot()) == nullptr)
+                break;
+
+            slot->row = row;
+            if (stale)
+                model->update_row (*slot->widget, row);
+            slot->widget->set_bounds (0, top - scroll, owner.width(), heights[row]);
+            slot->widget->set_visible (true);
+            top += heights[row];
+        }
+
+        for (auto& slot : slots)
+            if (slot.row < 0)
+                slot.widget->set_visible (false);
+
+        owner.repaint();
+    }
+
+    void refresh() {
+        heights.resize (model != nullptr ? static_cast<size_t> (std::max (0, model->num_rows())) : 0);
+        for (size_t i = 0; i < heights.size(); ++i)
+            heights[i] = std::max (0, model->row_height (static_cast<int> (i)));
+        offsets.assign (heights);
+        clamp_scroll();
+        layout (true);
+    }
+};
+
+} // namespace detail
+
+ListView::ListView() : impl (std::make_unique<detail::ListView> (*this)) {}
+ListView::~ListView() { impl.reset(); }
+
+void ListView::set_model (ListModel* model) {
+    if (impl->model == model)
+        return;
+    impl->slots.clear();
+    impl->model  = model;
+    impl->scroll = 0;
+    impl->refresh();
+}
+
+ListModel* ListView::model() const noexcept { return impl->model; }
+
+void ListView::refresh() { impl->refresh(); }
+
+void ListView::row_height_changed (int row) {
+    if (impl->model == nullptr || row < 0 || row >= impl->num_rows())
+        return;
+    const auto height = std::max (0, impl->model->row_height (row));
+    impl->offsets.add (static_cast<size_t> (row), height - impl->heights[row]);
+    impl->heights[row] = height;
+    impl->clamp_scroll();
+    impl->layout (false);
+}
+
+void ListView::row_changed (int row) {
+    if (auto slot = impl->slot_for (row)) {
+        impl->model->update_row (*slot->widget, row);
+        slot->widget->repaint();
+    }
+}
+
+int ListView::num_rows() const noexcept { return impl->num_rows(); }
+int ListView::content_height() const noexcept { return impl->offsets.total(); }
+int ListView::row_at (int y) const noexcept { return impl->row_at (y); }
+
+int ListView::row_position (int row) const noexcept {
+    return impl->offsets.sum (static_cast<size_t> (std::clamp (row, 0, impl->num_rows())));
+}
+
+void ListView::set_scroll_position (int y) {
+    const auto before = impl->scroll;
+    impl->scroll      = y;
+    impl->clamp_scroll();
+    if (impl->scroll != before)
+        impl->layout (false);
+}
+
+int ListView::scroll_position() const noexcept { return impl->scroll; }
+
+void ListView::scroll_to_row (int row) { set_scroll_position (row_position (row)); }
+
+Widget* ListView::row_widget (int row) const noexcept {
+    if (auto slot = impl->slot_for (row))
+        return slot->widget.get();
+    return nullptr;
+}
+
+int ListView::num_row_widgets() const noexcept { return static_cast<int> (impl->slots.size()); }
+
+void ListView::set_scroll_step (int pixels) { impl->step = std::max (1, pixels); }
+
+bool ListView::scroll (const ScrollEvent& ev) {
+    const auto before = impl->scroll;
+    set_scroll_position (before - static_cast<int> (std::lround (ev.delta.y * (float) impl->step)));
+    return impl->scroll != before;
+}
+
+void ListView::resized() {
+    impl->clamp_scroll();
+    impl->layout (false);
+}
+
+} // namespace lui
@@ -21,9 +21,31 @@ namespace detail {
 Main::Main (lui::Main& o, const Mode m, std::unique_ptr<lui::Backend> b)
     : owner (o),
       mode (m),
-      world (puglNewWorld (detail::world_type (m), detail::world_flags())),
+      world (puglNewWorld (detail::world_type (m), detail::world_flags (m))),
       backend (std::move (b)),
-      style (std::make_unique<DefaultStyle>()) {}
+      style (std::make_unique<DefaultStyle>()),
+      animator (std::make_unique<lui::Animator> (o)) {
+    style->_changed = [this] (uint64_t uses) { repaint_style_users (uses); };
+    // only programs own the loop, plugins are drained by the timer.
+    if (mode == Mode::PROGRAM)
+        waker = std::make_unique<Waker> ([this]() { send_wake(); });
+}
+
+void Main::repaint_style_users (uint64_t uses) {
+    for (auto view : views) {
+        view->impl->foreach_widget ([uses] (lui::Widget& w) {
+            if ((w.impl->style_uses & uses) != 0)
+                w.repaint();
+        });
+    }
+}
+
+void Main::end_repaints() {
+    if (repaint_depth <= 0 || --repaint_depth > 0)
+        return;
+    for (auto view : views)
+        view->impl->flush_damage();
+}
 
 std::unique_ptr<lui::View> Main::create_view (lui::Widget& widget, ViewFlags flags, uintptr_t parent) {
     auto view = backend->create_view (owner, widget);
@@ -42,8 +64,18 @@ std::unique_ptr<lui::View> Main::create_view (lui::Widget& widget, ViewFlags fla
     return view;
 }
 
+void Main::trim (TrimLevel level) {
+    for (auto view : views) {
+        view->trim_caches (level);
+        Widget::trim_render_lists (view->impl->widget);
+    }
+    FrameArena::current().release();
+}
+
 bool Main::loop (double timeout) {
+    drain_posted();
     last_update_status = puglUpdate (world, timeout);
+    drain_posted();
     if (! first_loop_called) {
         first_loop_called = true;
     }
@@ -67,6 +99,12 @@ bool Main::running() const noexcept { return impl->running(); }
 int Main::exit_code() const noexcept { return impl->exit_code.load(); }
 void Main::set_exit_code (int code) { impl->exit_code.store (code); }
 
+static_assert (Main::max_post_size == detail::MessageQueue::storage_size);
+
+bool Main::post_internal (void (*handler) (void*, bool), void (*construct) (void*, void*), void* source) noexcept {
+    return impl->post (handler, construct, source);
+}
+
 void Main::quit() {
     if (impl->quit_flag == true)
         return;
@@ -81,6 +119,7 @@ View* Main::elevate (Widget& widget, ViewFlags flags, uintptr_t parent) {
         widget.impl->view = std::move (vptr);
     if (widget.impl->view == nullptr)
         return nullptr;
+    ++detail::Widget::generation();
 
     auto& view = *widget.impl->view;
 
@@ -109,6 +148,30 @@ void* Main::handle() const noexcept {
     return puglGetNativeWorld (impl->world);
 }
 
+Animator& Main::animator() noexcept { return *impl->animator; }
+
+MemoryStats Main::memory_stats() const {
+    MemoryStats stats;
+    stats.images      = Image::total_bytes();
+    stats.frame_arena = FrameArena::current().stats().capacity;
+    stats.pool        = detail::pool::current().stats.chunk_bytes;
+    for (auto view : impl->views) {
+        view->add_memory_stats (stats);
+        detail::Widget::add_memory_stats (view->impl->widget, stats);
+    }
+    return stats;
+}
+
+MemoryStats Main::trim_memory (size_t budget) {
+    auto stats = memory_stats();
+    for (auto level : { TrimLevel::SCRATCH, TrimLevel::CACHES, TrimLevel::ALL }) {
+        if (stats.caches() <= budget)
+            break;
+        impl->trim (level);
+        stats = memory_stats();
+    }
+    return stats;
+}
 Style& Main::style() noexcept { return *impl->style; }
 const Style& Main::style() const noexcept { return *impl->style; }
 
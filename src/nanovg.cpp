@@ -1,7 +1,10 @@
 // Copyright 2022 Michael Fisher <mfisher@lvtk.org>
 // SPDX-License-Identifier: ISC
 
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -45,6 +48,21 @@ static uint64_t hash (uint8_t* data, size_t size) {
     return hash;
 }
 
+/** One of the fonts compiled in, so its coverage can lead a fallback chain. */
+class EmbeddedTypeface final : public Typeface {
+public:
+    EmbeddedTypeface (const char* n, const unsigned char* d, size_t s)
+        : _name (n), _data (d), _size (s) {}
+    std::string name() const noexcept override { return _name; }
+    const uint8_t* data() const noexcept override { return _data; }
+    size_t size() const noexcept override { return _size; }
+
+private:
+    std::string _name;
+    const uint8_t* _data;
+    size_t _size;
+};
+
 } // namespace detail
 
 namespace convert {
@@ -76,6 +94,7 @@ class Context::Ctx {
 
 public:
     Ctx() : ctx (detail::create (NVG_ANTIALIAS | NVG_STENCIL_STROKES)) {
+        stack.reserve (64);
         _font_normal = nvgCreateFontMem (ctx,
                                          detail::default_font_face,
                                          (uint8_t*) Roboto_Regular_ttf,
@@ -141,14 +160,98 @@ public:
     }
 
     void add_image (uint64_t key, int handle) { images[key] = handle; }
-    int find_image (uint64_t key) { return images[key]; }
+    int find_image (uint64_t key) {
+        auto it = images.find (key);
+        return it != images.end() ? it->second : 0;
+    }
+
+    /** Calls fn with each part of text and the font to draw it with, in
+        order, selecting that font first. Without a fallback chain the
+        whole text goes to the current font.
+
+        Parts come from the coverage of the current font followed by its
+        fallbacks, using FontFallback::runs(), so picking a face is a table
+        lookup per code point and is cached per string.
+     */
+    template <class Fn>
+    void each_run (std::string_view text, Fn&& fn) {
+        auto fallback = state.font.fallback();
+        if (fallback.empty()) {
+            fn (text);
+            return;
+        }
+
+        const auto& chain = chain_for (state.font_id == _font_bold ? 1 : 0, fallback);
+        for (const auto& run : chain.faces.runs (text)) {
+            // nothing covers it: let the base font draw its missing glyph.
+            nvgFontFaceId (ctx, run.face >= 0 ? chain.ids[(size_t) run.face] : state.font_id);
+            fn (text.substr (run.start, run.length));
+        }
+        nvgFontFaceId (ctx, state.font_id);
+    }
 
 private:
+    /** A built in font followed by the faces of a fallback chain. */
+    struct Chain {
+        FontFallback source;
+        FontFallback faces;
+        std::vector<int> ids; // NanoVG font of each face
+    };
+
+    /** Returns the chain of a built in font, rebuilding it for a new
+        fallback. Faces are registered with NanoVG once.
+     */
+    const Chain& chain_for (int bold, const FontFallback& fallback) {
+        auto& chain = chains[(size_t) bold];
+        if (chain.source == fallback && ! chain.ids.empty())
+            return chain;
+
+        auto& base = base_faces[(size_t) bold];
+        if (base == nullptr) {
+            base = bold != 0 ? std::make_shared<detail::EmbeddedTypeface> (detail::default_font_face_bold, Roboto_Bold_ttf, Roboto_Bold_ttf_size)
+                             : std::make_shared<detail::EmbeddedTypeface> (detail::default_font_face, Roboto_Regular_ttf, Roboto_Regular_ttf_size);
+        }
+
+        chain.source = fallback;
+        chain.faces  = FontFallback();
+        chain.ids.clear();
+        chain.faces.add (base);
+        chain.ids.push_back (bold != 0 ? _font_bold : _font_normal);
+
+        for (size_t i = 0; i < fallback.size(); ++i) {
+            auto face = fallback.face (i);
+            if (face->data() == nullptr || face->size() == 0)
+                continue;
+
+            auto it = faces.find (face.get());
+            if (it == faces.end()) {
+                const auto name = face->name() + "#" + std::to_string (faces.size());
+                const int id    = nvgCreateFontMem (ctx,
+                                                 name.c_str(),
+                                                 const_cast<uint8_t*> (face->data()),
+                                                 static_cast<int> (face->size()),
+                                                 0);
+                it              = faces.emplace (face.get(), std::make_pair (face, id)).first;
+            }
+
+            if (const auto id = it->second.second; id >= 0) {
+                chain.faces.add (face);
+                chain.ids.push_back (id);
+            }
+        }
+
+        return chain;
+    }
+
     friend class nvg::Context;
     NVGcontext* ctx { nullptr };
 
     std::unordered_map<uint64_t, int> images;
 
+    std::unordered_map<const Typeface*, std::pair<TypefacePtr, int>> faces;
+    std::array<TypefacePtr, 2> base_faces;
+    std::array<Chain, 2> chains; // normal and bold
+
     Point<float> last_pos;
     bool has_geometry = false; // Track if we've added geometry since last clear_path
 
@@ -203,6 +306,59 @@ void Context::end_frame() {
     nvgEndFrame (ctx->ctx);
 }
 
+void Context::prewarm (const Font& font, std::string_view glyphs, const std::vector<float>& sizes, double pixel_ratio) {
+    nvgSave (ctx->ctx);
+    nvgFontFaceId (ctx->ctx, font.bold() ? ctx->_font_bold : ctx->_font_normal);
+    for (const auto size : sizes)
+        nvgTextPrewarm (ctx->ctx, size, static_cast<float> (pixel_ratio), glyphs.data(), glyphs.data() + glyphs.size());
+    nvgRestore (ctx->ctx);
+}
+
+Context::AtlasStats Context::atlas_stats() const noexcept {
+    NVGfontAtlasStats fs;
+    nvgFontAtlasStats (ctx->ctx, &fs);
+    AtlasStats stats;
+    stats.pages                 = fs.pages;
+    stats.fill                  = fs.fill;
+    stats.rasterized            = fs.rasterized;
+    stats.rasterized_last_frame = fs.rasterizedLastFrame;
+    return stats;
+}
+
+void Context::add_memory_stats (MemoryStats& stats) const {
+    NVGmemoryStats ms;
+    nvgMemoryStats (ctx->ctx, &ms);
+    // pages live in memory and again as textures.
+    stats.font_atlas += (size_t) ms.atlasBytes * 2;
+    stats.path_cache += (size_t) ms.commandBytes + (size_t) ms.pathCacheBytes;
+
+    for (const auto& image : ctx->images) {
+        int width = 0, height = 0;
+        nvgImageSize (ctx->ctx, image.second, &width, &height);
+        stats.image_cache += (size_t) width * (size_t) height * 4;
+    }
+
+    stats.context_stacks += ctx->stack.capacity() * sizeof (Ctx::State);
+    for (const auto& state : ctx->stack)
+        stats.context_stacks += state.excluded.capacity() * sizeof (Rectangle<float>);
+    stats.context_stacks += ctx->state.excluded.capacity() * sizeof (Rectangle<float>);
+}
+
+void Context::trim_caches (TrimLevel level) {
+    ctx->stack.clear();
+    ctx->stack.shrink_to_fit();
+    ctx->state.excluded.clear();
+    ctx->state.excluded.shrink_to_fit();
+
+    if (level >= TrimLevel::CACHES) {
+        for (const auto& image : ctx->images)
+            nvgDeleteImage (ctx->ctx, image.second);
+        ctx->images.clear();
+    }
+
+    nvgTrimCaches (ctx->ctx, level >= TrimLevel::ALL ? 1 : 0);
+}
+
 double Context::device_scale() const noexcept {
     return ctx->internal_scale;
 }
@@ -401,7 +557,16 @@ TextMetrics Context::text_metrics (std::string_view text) const noexcept {
     float ascent, descent, lineheight;
 
     nvgTextMetrics (ctx->ctx, &ascent, &descent, &lineheight);
-    te.x_stride = nvgTextBounds (ctx->ctx, pt.x, pt.y, text.data(), nullptr, b);
+    float x    = pt.x;
+    bool first = true;
+    ctx->each_run (text, [&] (std::string_view part) {
+        float rb[4] = { 0.f };
+        x += nvgTextBounds (ctx->ctx, x, pt.y, part.data(), part.data() + part.size(), rb);
+        for (int i = 0; i < 4; ++i)
+            b[i] = first ? rb[i] : (i < 2 ? std::min (b[i], rb[i]) : std::max (b[i], rb[i]));
+        first = false;
+    });
+    te.x_stride = x - pt.x;
     te.width    = b[2] - b[0];
     te.height   = b[3] - b[1];
     te.x_offset = 0;
@@ -411,10 +576,42 @@ TextMetrics Context::text_metrics (std::string_view text) const noexcept {
     return te;
 }
 
+void Context::text_positions (std::string_view text, std::vector<float>& xs) const {
+    std::vector<NVGglyphPosition> glyphs (text.size());
+    float x = 0.f;
+    xs.clear();
+
+    ctx->each_run (text, [&] (std::string_view part) {
+        const auto end   = part.data() + part.size();
+        const auto count = nvgTextGlyphPositions (ctx->ctx, x, 0.f, part.data(), end, glyphs.data(), static_cast<int> (glyphs.size()));
+
+        int glyph = 0;
+        for (size_t i = 0; i < part.size(); ++i) {
+            if ((static_cast<uint8_t> (part[i]) & 0xC0) == 0x80)
+                continue;
+            while (glyph < count && glyphs[(size_t) glyph].str < part.data() + i)
+                ++glyph;
+            // code points without a glyph of their own sit where the last one did.
+            if (glyph < count && glyphs[(size_t) glyph].str == part.data() + i)
+                xs.push_back (glyphs[(size_t) glyph].x);
+            else
+                xs.push_back (xs.empty() ? x : xs.back());
+        }
+
+        float bounds[4] = { 0.f };
+        x += nvgTextBounds (ctx->ctx, x, 0.f, part.data(), end, bounds);
+    });
+
+    xs.push_back (x);
+}
+
 bool Context::show_text (std::string_view text) {
     nvgSave (ctx->ctx);
     nvgTextAlign (ctx->ctx, NVG_ALIGN_BASELINE | NVG_ALIGN_LEFT);
-    nvgText (ctx->ctx, ctx->last_pos.x, ctx->last_pos.y, text.data(), nullptr);
+    float x = ctx->last_pos.x;
+    ctx->each_run (text, [&] (std::string_view part) {
+        x = nvgText (ctx->ctx, x, ctx->last_pos.y, part.data(), part.data() + part.size());
+    });
     nvgRestore (ctx->ctx);
     return true;
 }
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <string_view>
+#include <vector>
+
 #include <lui/graphics.hpp>
 
 namespace lui {
@@ -17,6 +20,25 @@ public:
     void begin_frame (int width, int height, double pixel_ratio);
     void end_frame();
 
+    /** Font atlas usage counters. */
+    struct AtlasStats {
+        int pages { 0 };                 ///< Atlas pages (textures) in use.
+        float fill { 0.f };              ///< Fraction of page area in use.
+        int rasterized { 0 };            ///< Glyphs rasterized since creation.
+        int rasterized_last_frame { 0 }; ///< Glyphs rasterized during the last frame.
+    };
+
+    /** Rasterize glyphs in to the font atlas ahead of time.
+
+        Renders every code point of `glyphs` in `font` at each of `sizes` so
+        the first frame showing them doesn't stall on rasterization and
+        texture uploads. The GL context must be current.
+     */
+    void prewarm (const Font& font, std::string_view glyphs, const std::vector<float>& sizes, double pixel_ratio = 1.0);
+
+    /** Returns font atlas usage counters. */
+    AtlasStats atlas_stats() const noexcept;
+
     double device_scale() const noexcept override;
     void save() override;
     void restore() override;
@@ -45,8 +67,11 @@ public:
 
     FontMetrics font_metrics() const noexcept override;
     TextMetrics text_metrics (std::string_view text) const noexcept override;
+    void text_positions (std::string_view text, std::vector<float>& xs) const override;
     bool show_text (std::string_view) override;
     void draw_image (Image i, Transform matrix) override;
+    void add_memory_stats (MemoryStats& stats) const override;
+    void trim_caches (TrimLevel level) override;
 
     Font font() const noexcept override;
     void set_font (const Font& font) override;
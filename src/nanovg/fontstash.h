@@ -21,6 +21,12 @@
 
 #define FONS_INVALID -1
 
+// Maximum number of atlas pages. Glyphs never move once rasterized; when
+// every page is full a new one is started instead of resetting the atlas.
+#ifndef FONS_MAX_PAGES
+#	define FONS_MAX_PAGES 4
+#endif
+
 enum FONSflags {
 	FONS_ZERO_TOPLEFT = 1,
 	FONS_ZERO_BOTTOMLEFT = 2,
@@ -77,6 +83,7 @@ struct FONStextIter {
 	float x, y, nextx, nexty, scale, spacing;
 	unsigned int codepoint;
 	short isize, iblur;
+	int page;
 	struct FONSfont* font;
 	int prevGlyphIndex;
 	const char* str;
@@ -87,6 +94,14 @@ struct FONStextIter {
 };
 typedef struct FONStextIter FONStextIter;
 
+struct FONSatlasStats {
+	int pages;
+	int width, height;
+	float fill;
+	int rasterized;
+};
+typedef struct FONSatlasStats FONSatlasStats;
+
 typedef struct FONScontext FONScontext;
 
 // Constructor and destructor.
@@ -135,6 +150,14 @@ int fonsTextIterNext(FONScontext* stash, FONStextIter* iter, struct FONSquad* qu
 const unsigned char* fonsGetTextureData(FONScontext* stash, int* width, int* height);
 int fonsValidateTexture(FONScontext* s, int* dirty);
 
+// Atlas pages, all of the same size. Page 0 is the texture above.
+int fonsGetPageCount(FONScontext* s);
+const unsigned char* fonsGetPageData(FONScontext* s, int page, int* width, int* height);
+int fonsValidatePage(FONScontext* s, int page, int* dirty);
+
+// Usage counters. 'rasterized' counts every glyph bitmap rendered so far.
+void fonsGetAtlasStats(FONScontext* s, FONSatlasStats* stats);
+
 // Draws the stash texture for debugging
 void fonsDrawDebug(FONScontext* s, float x, float y);
 
@@ -225,6 +248,7 @@ struct FONSglyph
 	int index;
 	int next;
 	short size, blur;
+	short page;
 	short x0,y0,x1,y1;
 	short xadv,xoff,yoff;
 };
@@ -274,14 +298,22 @@ struct FONSatlas
 };
 typedef struct FONSatlas FONSatlas;
 
+struct FONSpage
+{
+	FONSatlas* atlas;
+	unsigned char* texData;
+	int dirtyRect[4];
+};
+typedef struct FONSpage FONSpage;
+
 struct FONScontext
 {
 	FONSparams params;
 	float itw,ith;
-	unsigned char* texData;
-	int dirtyRect[4];
+	FONSpage pages[FONS_MAX_PAGES];
+	int npages;
+	int nrasterized;
 	FONSfont** fonts;
-	FONSatlas* atlas;
 	int cfonts;
 	int nfonts;
 	float verts[FONS_VERTEX_COUNT*2];
@@ -709,25 +741,88 @@ static int fons__atlasAddRect(FONSatlas* atlas, int rw, int rh, int* rx, int* ry
 	return 1;
 }
 
+static void fons__resetDirty(FONScontext* stash, FONSpage* page)
+{
+	page->dirtyRect[0] = stash->params.width;
+	page->dirtyRect[1] = stash->params.height;
+	page->dirtyRect[2] = 0;
+	page->dirtyRect[3] = 0;
+}
+
+static void fons__addDirty(FONSpage* page, int x0, int y0, int x1, int y1)
+{
+	page->dirtyRect[0] = fons__mini(page->dirtyRect[0], x0);
+	page->dirtyRect[1] = fons__mini(page->dirtyRect[1], y0);
+	page->dirtyRect[2] = fons__maxi(page->dirtyRect[2], x1);
+	page->dirtyRect[3] = fons__maxi(page->dirtyRect[3], y1);
+}
+
+static void fons__freePage(FONSpage* page)
+{
+	if (page->atlas) fons__deleteAtlas(page->atlas);
+	if (page->texData) free(page->texData);
+	memset(page, 0, sizeof(FONSpage));
+}
+
+static int fons__addPage(FONScontext* stash)
+{
+	FONSpage* page;
+	int size = stash->params.width * stash->params.height;
+
+	if (stash->npages >= FONS_MAX_PAGES)
+		return 0;
+	// The render callbacks only know about a single texture.
+	if (stash->npages > 0 && (stash->params.renderUpdate != NULL || stash->params.renderDraw != NULL))
+		return 0;
+
+	page = &stash->pages[stash->npages];
+	page->atlas = fons__allocAtlas(stash->params.width, stash->params.height, FONS_INIT_ATLAS_NODES);
+	page->texData = (unsigned char*)malloc(size);
+	if (page->atlas == NULL || page->texData == NULL) {
+		fons__freePage(page);
+		return 0;
+	}
+	memset(page->texData, 0, size);
+	fons__resetDirty(stash, page);
+
+	++stash->npages;
+	return 1;
+}
+
+// Finds room for a rect on any page, starting a new page when all are full.
+static int fons__allocRect(FONScontext* stash, int w, int h, int* rx, int* ry, int* rpage)
+{
+	int i;
+	for (i = 0; i < stash->npages; ++i) {
+		if (fons__atlasAddRect(stash->pages[i].atlas, w, h, rx, ry)) {
+			*rpage = i;
+			return 1;
+		}
+	}
+	if (fons__addPage(stash) && fons__atlasAddRect(stash->pages[stash->npages-1].atlas, w, h, rx, ry)) {
+		*rpage = stash->npages-1;
+		return 1;
+	}
+	return 0;
+}
+
 static void fons__addWhiteRect(FONScontext* stash, int w, int h)
 {
 	int x, y, gx, gy;
 	unsigned char* dst;
-	if (fons__atlasAddRect(stash->atlas, w, h, &gx, &gy) == 0)
+	FONSpage* page = &stash->pages[0];
+	if (fons__atlasAddRect(page->atlas, w, h, &gx, &gy) == 0)
 		return;
 
 	// Rasterize
-	dst = &stash->texData[gx + gy * stash->params.width];
+	dst = &page->texData[gx + gy * stash->params.width];
 	for (y = 0; y < h; y++) {
 		for (x = 0; x < w; x++)
 			dst[x] = 0xff;
 		dst += stash->params.width;
 	}
 
-	stash->dirtyRect[0] = fons__mini(stash->dirtyRect[0], gx);
-	stash->dirtyRect[1] = fons__mini(stash->dirtyRect[1], gy);
-	stash->dirtyRect[2] = fons__maxi(stash->dirtyRect[2], gx+w);
-	stash->dirtyRect[3] = fons__maxi(stash->dirtyRect[3], gy+h);
+	fons__addDirty(page, gx, gy, gx+w, gy+h);
 }
 
 FONScontext* fonsCreateInternal(FONSparams* params)
@@ -753,9 +848,6 @@ FONScontext* fonsCreateInternal(FONSparams* params)
 			goto error;
 	}
 
-	stash->atlas = fons__allocAtlas(stash->params.width, stash->params.height, FONS_INIT_ATLAS_NODES);
-	if (stash->atlas == NULL) goto error;
-
 	// Allocate space for fonts.
 	stash->fonts = (FONSfont**)malloc(sizeof(FONSfont*) * FONS_INIT_FONTS);
 	if (stash->fonts == NULL) goto error;
@@ -763,17 +855,10 @@ FONScontext* fonsCreateInternal(FONSparams* params)
 	stash->cfonts = FONS_INIT_FONTS;
 	stash->nfonts = 0;
 
-	// Create texture for the cache.
+	// Create the first page of the cache.
 	stash->itw = 1.0f/stash->params.width;
 	stash->ith = 1.0f/stash->params.height;
-	stash->texData = (unsigned char*)malloc(stash->params.width * stash->params.height);
-	if (stash->texData == NULL) goto error;
-	memset(stash->texData, 0, stash->params.width * stash->params.height);
-
-	stash->dirtyRect[0] = stash->params.width;
-	stash->dirtyRect[1] = stash->params.height;
-	stash->dirtyRect[2] = 0;
-	stash->dirtyRect[3] = 0;
+	if (!fons__addPage(stash)) goto error;
 
 	// Add white rect at 0,0 for debug drawing.
 	fons__addWhiteRect(stash, 2,2);
@@ -1080,9 +1165,10 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	FONSglyph* glyph = NULL;
 	unsigned int h;
 	float size = isize/10.0f;
-	int pad, added;
+	int pad, added, gp = 0;
 	unsigned char* bdst;
 	unsigned char* dst;
+	FONSpage* page;
 	FONSfont* renderFont = font;
 
 	if (isize < 2) return NULL;
@@ -1131,11 +1217,11 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	// Determines the spot to draw glyph in the atlas.
 	if (bitmapOption == FONS_GLYPH_BITMAP_REQUIRED) {
 		// Find free spot for the rect in the atlas
-		added = fons__atlasAddRect(stash->atlas, gw, gh, &gx, &gy);
+		added = fons__allocRect(stash, gw, gh, &gx, &gy, &gp);
 		if (added == 0 && stash->handleError != NULL) {
-			// Atlas is full, let the user to resize the atlas (or not), and try again.
+			// Every page is full, let the user to resize the atlas (or not), and try again.
 			stash->handleError(stash->errorUptr, FONS_ATLAS_FULL, 0);
-			added = fons__atlasAddRect(stash->atlas, gw, gh, &gx, &gy);
+			added = fons__allocRect(stash, gw, gh, &gx, &gy, &gp);
 		}
 		if (added == 0) return NULL;
 	} else {
@@ -1157,6 +1243,7 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 		font->lut[h] = font->nglyphs-1;
 	}
 	glyph->index = g;
+	glyph->page = (short)gp;
 	glyph->x0 = (short)gx;
 	glyph->y0 = (short)gy;
 	glyph->x1 = (short)(glyph->x0+gw);
@@ -1170,11 +1257,13 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	}
 
 	// Rasterize
-	dst = &stash->texData[(glyph->x0+pad) + (glyph->y0+pad) * stash->params.width];
+	page = &stash->pages[gp];
+	dst = &page->texData[(glyph->x0+pad) + (glyph->y0+pad) * stash->params.width];
 	fons__tt_renderGlyphBitmap(&renderFont->font, dst, gw-pad*2,gh-pad*2, stash->params.width, scale, scale, g);
+	++stash->nrasterized;
 
 	// Make sure there is one pixel empty border.
-	dst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
+	dst = &page->texData[glyph->x0 + glyph->y0 * stash->params.width];
 	for (y = 0; y < gh; y++) {
 		dst[y*stash->params.width] = 0;
 		dst[gw-1 + y*stash->params.width] = 0;
@@ -1185,7 +1274,7 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	}
 
 	// Debug code to color the glyph background
-/*	unsigned char* fdst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
+/*	unsigned char* fdst = &page->texData[glyph->x0 + glyph->y0 * stash->params.width];
 	for (y = 0; y < gh; y++) {
 		for (x = 0; x < gw; x++) {
 			int a = (int)fdst[x+y*stash->params.width] + 20;
@@ -1197,14 +1286,11 @@ static FONSglyph* fons__getGlyph(FONScontext* stash, FONSfont* font, unsigned in
 	// Blur
 	if (iblur > 0) {
 		stash->nscratch = 0;
-		bdst = &stash->texData[glyph->x0 + glyph->y0 * stash->params.width];
+		bdst = &page->texData[glyph->x0 + glyph->y0 * stash->params.width];
 		fons__blur(stash, bdst, gw, gh, stash->params.width, iblur);
 	}
 
-	stash->dirtyRect[0] = fons__mini(stash->dirtyRect[0], glyph->x0);
-	stash->dirtyRect[1] = fons__mini(stash->dirtyRect[1], glyph->y0);
-	stash->dirtyRect[2] = fons__maxi(stash->dirtyRect[2], glyph->x1);
-	stash->dirtyRect[3] = fons__maxi(stash->dirtyRect[3], glyph->y1);
+	fons__addDirty(page, glyph->x0, glyph->y0, glyph->x1, glyph->y1);
 
 	return glyph;
 }
@@ -1263,15 +1349,12 @@ static void fons__getQuad(FONScontext* stash, FONSfont* font,
 
 static void fons__flush(FONScontext* stash)
 {
-	// Flush texture
-	if (stash->dirtyRect[0] < stash->dirtyRect[2] && stash->dirtyRect[1] < stash->dirtyRect[3]) {
+	// Flush texture. Render callbacks restrict the stash to a single page.
+	FONSpage* page = &stash->pages[0];
+	if (page->dirtyRect[0] < page->dirtyRect[2] && page->dirtyRect[1] < page->dirtyRect[3]) {
 		if (stash->params.renderUpdate != NULL)
-			stash->params.renderUpdate(stash->params.userPtr, stash->dirtyRect, stash->texData);
-		// Reset dirty rect
-		stash->dirtyRect[0] = stash->params.width;
-		stash->dirtyRect[1] = stash->params.height;
-		stash->dirtyRect[2] = 0;
-		stash->dirtyRect[3] = 0;
+			stash->params.renderUpdate(stash->params.userPtr, page->dirtyRect, page->texData);
+		fons__resetDirty(stash, page);
 	}
 
 	// Flush triangles
@@ -1446,8 +1529,10 @@ int fonsTextIterNext(FONScontext* stash, FONStextIter* iter, FONSquad* quad)
 		iter->y = iter->nexty;
 		glyph = fons__getGlyph(stash, iter->font, iter->codepoint, iter->isize, iter->iblur, iter->bitmapOption);
 		// If the iterator was initialized with FONS_GLYPH_BITMAP_OPTIONAL, then the UV coordinates of the quad will be invalid.
-		if (glyph != NULL)
+		if (glyph != NULL) {
 			fons__getQuad(stash, iter->font, iter->prevGlyphIndex, glyph, iter->scale, iter->spacing, &iter->nextx, &iter->nexty, quad);
+			iter->page = glyph->page;
+		}
 		iter->prevGlyphIndex = glyph != NULL ? glyph->index : -1;
 		break;
 	}
@@ -1486,8 +1571,8 @@ void fonsDrawDebug(FONScontext* stash, float x, float y)
 	fons__vertex(stash, x+w, y+h, 1, 1, 0xffffffff);
 
 	// Drawbug draw atlas
-	for (i = 0; i < stash->atlas->nnodes; i++) {
-		FONSatlasNode* n = &stash->atlas->nodes[i];
+	for (i = 0; i < stash->pages[0].atlas->nnodes; i++) {
+		FONSatlasNode* n = &stash->pages[0].atlas->nodes[i];
 
 		if (stash->nverts+6 > FONS_VERTEX_COUNT)
 			fons__flush(stash);
@@ -1626,31 +1711,70 @@ void fonsLineBounds(FONScontext* stash, float y, float* miny, float* maxy)
 }
 
 const unsigned char* fonsGetTextureData(FONScontext* stash, int* width, int* height)
+{
+	return fonsGetPageData(stash, 0, width, height);
+}
+
+int fonsValidateTexture(FONScontext* stash, int* dirty)
+{
+	return fonsValidatePage(stash, 0, dirty);
+}
+
+int fonsGetPageCount(FONScontext* stash)
+{
+	return stash != NULL ? stash->npages : 0;
+}
+
+const unsigned char* fonsGetPageData(FONScontext* stash, int page, int* width, int* height)
 {
 	if (width != NULL)
 		*width = stash->params.width;
 	if (height != NULL)
 		*height = stash->params.height;
-	return stash->texData;
+	if (page < 0 || page >= stash->npages)
+		return NULL;
+	return stash->pages[page].texData;
 }
 
-int fonsValidateTexture(FONScontext* stash, int* dirty)
+int fonsValidatePage(FONScontext* stash, int page, int* dirty)
 {
-	if (stash->dirtyRect[0] < stash->dirtyRect[2] && stash->dirtyRect[1] < stash->dirtyRect[3]) {
-		dirty[0] = stash->dirtyRect[0];
-		dirty[1] = stash->dirtyRect[1];
-		dirty[2] = stash->dirtyRect[2];
-		dirty[3] = stash->dirtyRect[3];
-		// Reset dirty rect
-		stash->dirtyRect[0] = stash->params.width;
-		stash->dirtyRect[1] = stash->params.height;
-		stash->dirtyRect[2] = 0;
-		stash->dirtyRect[3] = 0;
+	FONSpage* p;
+	if (page < 0 || page >= stash->npages)
+		return 0;
+	p = &stash->pages[page];
+	if (p->dirtyRect[0] < p->dirtyRect[2] && p->dirtyRect[1] < p->dirtyRect[3]) {
+		dirty[0] = p->dirtyRect[0];
+		dirty[1] = p->dirtyRect[1];
+		dirty[2] = p->dirtyRect[2];
+		dirty[3] = p->dirtyRect[3];
+		fons__resetDirty(stash, p);
 		return 1;
 	}
 	return 0;
 }
 
+void fonsGetAtlasStats(FONScontext* stash, FONSatlasStats* stats)
+{
+	int i, j;
+	float used = 0.0f;
+	memset(stats, 0, sizeof(*stats));
+	if (stash == NULL) return;
+
+	// Area under the skyline; free pockets below it count as used.
+	for (i = 0; i < stash->npages; ++i) {
+		FONSatlas* atlas = stash->pages[i].atlas;
+		for (j = 0; j < atlas->nnodes; ++j)
+			used += (float)atlas->nodes[j].width * (float)atlas->nodes[j].y;
+	}
+
+	stats->pages = stash->npages;
+	stats->width = stash->params.width;
+	stats->height = stash->params.height;
+	if (stash->npages > 0)
+		stats->fill = used / ((float)stash->params.width * (float)stash->params.height * (float)stash->npages);
+	stats->rasterized = stash->nrasterized;
+}
+
 void fonsDeleteInternal(FONScontext* stash)
 {
 	int i;
@@ -1662,9 +1786,9 @@ void fonsDeleteInternal(FONScontext* stash)
 	for (i = 0; i < stash->nfonts; ++i)
 		fons__freeFont(stash->fonts[i]);
 
-	if (stash->atlas) fons__deleteAtlas(stash->atlas);
+	for (i = 0; i < stash->npages; ++i)
+		fons__freePage(&stash->pages[i]);
 	if (stash->fonts) free(stash->fonts);
-	if (stash->texData) free(stash->texData);
 	if (stash->scratch) free(stash->scratch);
 	fons__tt_done(stash);
 	free(stash);
@@ -1686,8 +1810,8 @@ void fonsGetAtlasSize(FONScontext* stash, int* width, int* height)
 
 int fonsExpandAtlas(FONScontext* stash, int width, int height)
 {
-	int i, maxy = 0;
-	unsigned char* data = NULL;
+	int i, p, maxy;
+	unsigned char* data[FONS_MAX_PAGES];
 	if (stash == NULL) return 0;
 
 	width = fons__maxi(width, stash->params.width);
@@ -1696,41 +1820,56 @@ int fonsExpandAtlas(FONScontext* stash, int width, int height)
 	if (width == stash->params.width && height == stash->params.height)
 		return 1;
 
+	// Allocate every page first, so a failure leaves the stash untouched.
+	for (p = 0; p < stash->npages; p++) {
+		data[p] = (unsigned char*)malloc(width * height);
+		if (data[p] == NULL) {
+			while (p-- > 0)
+				free(data[p]);
+			return 0;
+		}
+	}
+
 	// Flush pending glyphs.
 	fons__flush(stash);
 
 	// Create new texture
 	if (stash->params.renderResize != NULL) {
-		if (stash->params.renderResize(stash->params.userPtr, width, height) == 0)
+		if (stash->params.renderResize(stash->params.userPtr, width, height) == 0) {
+			for (p = 0; p < stash->npages; p++)
+				free(data[p]);
 			return 0;
+		}
 	}
-	// Copy old texture data over.
-	data = (unsigned char*)malloc(width * height);
-	if (data == NULL)
-		return 0;
-	for (i = 0; i < stash->params.height; i++) {
-		unsigned char* dst = &data[i*width];
-		unsigned char* src = &stash->texData[i*stash->params.width];
-		memcpy(dst, src, stash->params.width);
-		if (width > stash->params.width)
-			memset(dst+stash->params.width, 0, width - stash->params.width);
+	for (p = 0; p < stash->npages; p++) {
+		FONSpage* page = &stash->pages[p];
+
+		// Copy old texture data over.
+		for (i = 0; i < stash->params.height; i++) {
+			unsigned char* dst = &data[p][i*width];
+			unsigned char* src = &page->texData[i*stash->params.width];
+			memcpy(dst, src, stash->params.width);
+			if (width > stash->params.width)
+				memset(dst+stash->params.width, 0, width - stash->params.width);
+		}
+		if (height > stash->params.height)
+			memset(&data[p][stash->params.height * width], 0, (height - stash->params.height) * width);
+
+		free(page->texData);
+		page->texData = data[p];
+
+		// Increase atlas size
+		fons__atlasExpand(page->atlas, width, height);
+
+		// Add existing data as dirty.
+		maxy = 0;
+		for (i = 0; i < page->atlas->nnodes; i++)
+			maxy = fons__maxi(maxy, page->atlas->nodes[i].y);
+		page->dirtyRect[0] = 0;
+		page->dirtyRect[1] = 0;
+		page->dirtyRect[2] = stash->params.width;
+		page->dirtyRect[3] = maxy;
 	}
-	if (height > stash->params.height)
-		memset(&data[stash->params.height * width], 0, (height - stash->params.height) * width);
-
-	free(stash->texData);
-	stash->texData = data;
-
-	// Increase atlas size
-	fons__atlasExpand(stash->atlas, width, height);
-
-	// Add existing data as dirty.
-	for (i = 0; i < stash->atlas->nnodes; i++)
-		maxy = fons__maxi(maxy, stash->atlas->nodes[i].y);
-	stash->dirtyRect[0] = 0;
-	stash->dirtyRect[1] = 0;
-	stash->dirtyRect[2] = stash->params.width;
-	stash->dirtyRect[3] = maxy;
 
 	stash->params.width = width;
 	stash->params.height = height;
@@ -1743,30 +1882,40 @@ int fonsExpandAtlas(FONScontext* stash, int width, int height)
 int fonsResetAtlas(FONScontext* stash, int width, int height)
 {
 	int i, j;
+	unsigned char* data;
 	if (stash == NULL) return 0;
 
 	// Flush pending glyphs.
 	fons__flush(stash);
 
+	// Allocate the first page's data before changing anything.
+	data = (unsigned char*)malloc(width * height);
+	if (data == NULL) return 0;
+
 	// Create new texture
 	if (stash->params.renderResize != NULL) {
-		if (stash->params.renderResize(stash->params.userPtr, width, height) == 0)
+		if (stash->params.renderResize(stash->params.userPtr, width, height) == 0) {
+			free(data);
 			return 0;
+		}
 	}
+	free(stash->pages[0].texData);
+	stash->pages[0].texData = data;
 
-	// Reset atlas
-	fons__atlasReset(stash->atlas, width, height);
+	// Drop all but the first page and reset it.
+	for (i = 1; i < stash->npages; i++)
+		fons__freePage(&stash->pages[i]);
+	stash->npages = 1;
+	fons__atlasReset(stash->pages[0].atlas, width, height);
 
 	// Clear texture data.
-	stash->texData = (unsigned char*)realloc(stash->texData, width * height);
-	if (stash->texData == NULL) return 0;
-	memset(stash->texData, 0, width * height);
+	memset(stash->pages[0].texData, 0, width * height);
 
 	// Reset dirty rect
-	stash->dirtyRect[0] = width;
-	stash->dirtyRect[1] = height;
-	stash->dirtyRect[2] = 0;
-	stash->dirtyRect[3] = 0;
+	stash->pages[0].dirtyRect[0] = width;
+	stash->pages[0].dirtyRect[1] = height;
+	stash->pages[0].dirtyRect[2] = 0;
+	stash->pages[0].dirtyRect[3] = 0;
 
 	// Reset cached glyphs
 	for (i = 0; i < stash->nfonts; i++) {
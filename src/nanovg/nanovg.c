@@ -38,9 +38,12 @@
 #pragma warning(disable: 4706)  // assignment within conditional expression
 #endif
 
-#define NVG_INIT_FONTIMAGE_SIZE  512
-#define NVG_MAX_FONTIMAGE_SIZE   2048
-#define NVG_MAX_FONTIMAGES       4
+// Font atlas pages have a fixed size and are never resized, so glyphs stay put
+// once rasterized. A new page is added when the existing ones are full.
+#ifndef NVG_FONTIMAGE_SIZE
+#define NVG_FONTIMAGE_SIZE       1024
+#endif
+#define NVG_MAX_FONTIMAGES       FONS_MAX_PAGES
 
 #define NVG_INIT_COMMANDS_SIZE 256
 #define NVG_INIT_POINTS_SIZE 128
@@ -128,7 +131,10 @@ struct NVGcontext {
 	float devicePxRatio;
 	struct FONScontext* fs;
 	int fontImages[NVG_MAX_FONTIMAGES];
-	int fontImageIdx;
+	int retiredFontImages[NVG_MAX_FONTIMAGES];
+	int nretiredFontImages;
+	int rasterizedFrameStart;
+	int rasterizedLastFrame;
 	int drawCallCount;
 	int fillTriCount;
 	int strokeTriCount;
@@ -316,8 +322,8 @@ NVGcontext* nvgCreateInternal(NVGparams* params)
 
 	// Init font rendering
 	memset(&fontParams, 0, sizeof(fontParams));
-	fontParams.width = NVG_INIT_FONTIMAGE_SIZE;
-	fontParams.height = NVG_INIT_FONTIMAGE_SIZE;
+	fontParams.width = NVG_FONTIMAGE_SIZE;
+	fontParams.height = NVG_FONTIMAGE_SIZE;
 	fontParams.flags = FONS_ZERO_TOPLEFT;
 	fontParams.renderCreate = NULL;
 	fontParams.renderUpdate = NULL;
@@ -330,7 +336,6 @@ NVGcontext* nvgCreateInternal(NVGparams* params)
 	// Create font texture
 	ctx->fontImages[0] = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, fontParams.width, fontParams.height, 0, NULL);
 	if (ctx->fontImages[0] == 0) goto error;
-	ctx->fontImageIdx = 0;
 
 	return ctx;
 
@@ -344,10 +349,21 @@ NVGparams* nvgInternalParams(NVGcontext* ctx)
     return &ctx->params;
 }
 
+// Font textures replaced during a frame may still be used by its queued
+// draw calls, so they are only deleted once the frame is done.
+static void nvg__deleteRetiredFontImages(NVGcontext* ctx)
+{
+	int i;
+	for (i = 0; i < ctx->nretiredFontImages; i++)
+		nvgDeleteImage(ctx, ctx->retiredFontImages[i]);
+	ctx->nretiredFontImages = 0;
+}
+
 void nvgDeleteInternal(NVGcontext* ctx)
 {
 	int i;
 	if (ctx == NULL) return;
+	nvg__deleteRetiredFontImages(ctx);
 	if (ctx->commands != NULL) free(ctx->commands);
 	if (ctx->cache != NULL) nvg__deletePathCache(ctx->cache);
 
@@ -385,41 +401,20 @@ void nvgBeginFrame(NVGcontext* ctx, float windowWidth, float windowHeight, float
 	ctx->fillTriCount = 0;
 	ctx->strokeTriCount = 0;
 	ctx->textTriCount = 0;
+	ctx->rasterizedFrameStart = ctx->fs->nrasterized;
 }
 
 void nvgCancelFrame(NVGcontext* ctx)
 {
 	ctx->params.renderCancel(ctx->params.userPtr);
+	nvg__deleteRetiredFontImages(ctx);
 }
 
 void nvgEndFrame(NVGcontext* ctx)
 {
 	ctx->params.renderFlush(ctx->params.userPtr);
-	if (ctx->fontImageIdx != 0) {
-		int fontImage = ctx->fontImages[ctx->fontImageIdx];
-		ctx->fontImages[ctx->fontImageIdx] = 0;
-		int i, j, iw, ih;
-		// delete images that smaller than current one
-		if (fontImage == 0)
-			return;
-		nvgImageSize(ctx, fontImage, &iw, &ih);
-		for (i = j = 0; i < ctx->fontImageIdx; i++) {
-			if (ctx->fontImages[i] != 0) {
-				int nw, nh;
-				int image = ctx->fontImages[i];
-				ctx->fontImages[i] = 0;
-				nvgImageSize(ctx, image, &nw, &nh);
-				if (nw < iw || nh < ih)
-					nvgDeleteImage(ctx, image);
-				else
-					ctx->fontImages[j++] = image;
-			}
-		}
-		// make current font image to first
-		ctx->fontImages[j] = ctx->fontImages[0];
-		ctx->fontImages[0] = fontImage;
-		ctx->fontImageIdx = 0;
-	}
+	nvg__deleteRetiredFontImages(ctx);
+	ctx->rasterizedLastFrame = ctx->fs->nrasterized - ctx->rasterizedFrameStart;
 }
 
 NVGcolor nvgRGB(unsigned char r, unsigned char g, unsigned char b)
@@ -2407,53 +2402,57 @@ static float nvg__getFontScale(NVGstate* state)
 static void nvg__flushTextTexture(NVGcontext* ctx)
 {
 	int dirty[4];
+	int page, npages = fonsGetPageCount(ctx->fs);
 
-	if (fonsValidateTexture(ctx->fs, dirty)) {
-		int fontImage = ctx->fontImages[ctx->fontImageIdx];
-		// Update texture
-		if (fontImage != 0) {
-			int iw, ih;
-			const unsigned char* data = fonsGetTextureData(ctx->fs, &iw, &ih);
+	for (page = 0; page < npages; page++) {
+		int iw, ih;
+		const unsigned char* data = fonsGetPageData(ctx->fs, page, &iw, &ih);
+
+		// Pages added by the stash get their texture on first upload.
+		if (ctx->fontImages[page] == 0)
+			ctx->fontImages[page] = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, iw, ih, 0, NULL);
+
+		if (fonsValidatePage(ctx->fs, page, dirty) && ctx->fontImages[page] != 0) {
 			int x = dirty[0];
 			int y = dirty[1];
 			int w = dirty[2] - dirty[0];
 			int h = dirty[3] - dirty[1];
-			ctx->params.renderUpdateTexture(ctx->params.userPtr, fontImage, x,y, w,h, data);
+			ctx->params.renderUpdateTexture(ctx->params.userPtr, ctx->fontImages[page], x,y, w,h, data);
 		}
 	}
 }
 
+// Last resort when every atlas page is full: start over with a single empty page.
+// Draws already queued this frame sample the current textures, so they are
+// retired until nvgEndFrame and the new pages get fresh textures. Only one
+// reset is allowed per frame, like upstream's limit on font images.
 static int nvg__allocTextAtlas(NVGcontext* ctx)
 {
-	int iw, ih;
+	int i;
 	nvg__flushTextTexture(ctx);
-	if (ctx->fontImageIdx >= NVG_MAX_FONTIMAGES-1)
+	if (fonsGetPageCount(ctx->fs) < NVG_MAX_FONTIMAGES || ctx->nretiredFontImages > 0)
 		return 0;
-	// if next fontImage already have a texture
-	if (ctx->fontImages[ctx->fontImageIdx+1] != 0)
-		nvgImageSize(ctx, ctx->fontImages[ctx->fontImageIdx+1], &iw, &ih);
-	else { // calculate the new font image size and create it.
-		nvgImageSize(ctx, ctx->fontImages[ctx->fontImageIdx], &iw, &ih);
-		if (iw > ih)
-			ih *= 2;
-		else
-			iw *= 2;
-		if (iw > NVG_MAX_FONTIMAGE_SIZE || ih > NVG_MAX_FONTIMAGE_SIZE)
-			iw = ih = NVG_MAX_FONTIMAGE_SIZE;
-		ctx->fontImages[ctx->fontImageIdx+1] = ctx->params.renderCreateTexture(ctx->params.userPtr, NVG_TEXTURE_ALPHA, iw, ih, 0, NULL);
+	if (!fonsResetAtlas(ctx->fs, NVG_FONTIMAGE_SIZE, NVG_FONTIMAGE_SIZE))
+		return 0;
+	for (i = 0; i < NVG_MAX_FONTIMAGES; i++) {
+		if (ctx->fontImages[i] != 0) {
+			ctx->retiredFontImages[ctx->nretiredFontImages++] = ctx->fontImages[i];
+			ctx->fontImages[i] = 0;
+		}
 	}
-	++ctx->fontImageIdx;
-	fonsResetAtlas(ctx->fs, iw, ih);
 	return 1;
 }
 
-static void nvg__renderText(NVGcontext* ctx, NVGvertex* verts, int nverts)
+static void nvg__renderText(NVGcontext* ctx, NVGvertex* verts, int nverts, int page)
 {
 	NVGstate* state = nvg__getState(ctx);
 	NVGpaint paint = state->fill;
 
+	if (nverts <= 0)
+		return;
+
 	// Render triangles.
-	paint.image = ctx->fontImages[ctx->fontImageIdx];
+	paint.image = ctx->fontImages[page];
 
 	// Apply global alpha
 	paint.innerColor.a *= state->alpha;
@@ -2481,6 +2480,7 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 	float invscale = 1.0f / scale;
 	int cverts = 0;
 	int nverts = 0;
+	int page = 0;
 	int isFlipped = nvg__isTransformFlipped(state->xform);
 
 	if (end == NULL)
@@ -2504,7 +2504,8 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 		float c[4*2];
 		if (iter.prevGlyphIndex == -1) { // can not retrieve glyph?
 			if (nverts != 0) {
-				nvg__renderText(ctx, verts, nverts);
+				nvg__flushTextTexture(ctx);
+				nvg__renderText(ctx, verts, nverts, page);
 				nverts = 0;
 			}
 			if (!nvg__allocTextAtlas(ctx))
@@ -2515,6 +2516,14 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 				break;
 		}
 		prevIter = iter;
+		if (iter.page != page) { // glyphs on another atlas page need their own draw
+			if (nverts != 0) {
+				nvg__flushTextTexture(ctx);
+				nvg__renderText(ctx, verts, nverts, page);
+				nverts = 0;
+			}
+			page = iter.page;
+		}
 		if(isFlipped) {
 			float tmp;
 
@@ -2540,11 +2549,96 @@ float nvgText(NVGcontext* ctx, float x, float y, const char* string, const char*
 	// TODO: add back-end bit to do this just once per frame.
 	nvg__flushTextTexture(ctx);
 
-	nvg__renderText(ctx, verts, nverts);
+	nvg__renderText(ctx, verts, nverts, page);
 
 	return iter.nextx / scale;
 }
 
+void nvgTextPrewarm(NVGcontext* ctx, float size, float devicePixelRatio, const char* string, const char* end)
+{
+	NVGstate* state = nvg__getState(ctx);
+	FONStextIter iter;
+	FONSquad q;
+	float scale = nvg__getFontScale(state) * devicePixelRatio;
+
+	if (state->fontId == FONS_INVALID) return;
+
+	if (end == NULL)
+		end = string + strlen(string);
+
+	fonsPushState(ctx->fs);
+	fonsSetSize(ctx->fs, size*scale);
+	fonsSetSpacing(ctx->fs, state->letterSpacing*scale);
+	fonsSetBlur(ctx->fs, state->fontBlur*scale);
+	fonsSetAlign(ctx->fs, NVG_ALIGN_LEFT | NVG_ALIGN_BASELINE);
+	fonsSetFont(ctx->fs, state->fontId);
+
+	fonsTextIterInit(ctx->fs, &iter, 0, 0, string, end, FONS_GLYPH_BITMAP_REQUIRED);
+	while (fonsTextIterNext(ctx->fs, &iter, &q)) {
+		if (iter.prevGlyphIndex == -1 && fonsGetPageCount(ctx->fs) >= NVG_MAX_FONTIMAGES)
+			break; // atlas is full, don't evict what's already there
+	}
+
+	fonsPopState(ctx->fs);
+	nvg__flushTextTexture(ctx);
+}
+
+void nvgFontAtlasStats(NVGcontext* ctx, NVGfontAtlasStats* stats)
+{
+	FONSatlasStats fs;
+	fonsGetAtlasStats(ctx->fs, &fs);
+	stats->pages = fs.pages;
+	stats->pageWidth = fs.width;
+	stats->pageHeight = fs.height;
+	stats->fill = fs.fill;
+	stats->rasterized = fs.rasterized;
+	stats->rasterizedLastFrame = ctx->rasterizedLastFrame;
+}
+
+void nvgMemoryStats(NVGcontext* ctx, NVGmemoryStats* stats)
+{
+	FONSatlasStats fs;
+	NVGpathCache* c = ctx->cache;
+	fonsGetAtlasStats(ctx->fs, &fs);
+	stats->commandBytes = ctx->ccommands * (int)sizeof(float);
+	stats->pathCacheBytes = c->cpoints * (int)sizeof(NVGpoint)
+						  + c->cpaths * (int)sizeof(NVGpath)
+						  + c->cverts * (int)sizeof(NVGvertex);
+	stats->atlasBytes = fs.pages * fs.width * fs.height;
+}
+
+static void* nvg__shrink(void* ptr, int* capacity, int initial, int size)
+{
+	void* p;
+	if (*capacity <= initial) return ptr;
+	p = realloc(ptr, initial * size);
+	if (p == NULL) return ptr;
+	*capacity = initial;
+	return p;
+}
+
+void nvgTrimCaches(NVGcontext* ctx, int dropGlyphs)
+{
+	int i;
+	NVGpathCache* c = ctx->cache;
+
+	ctx->ncommands = 0;
+	ctx->commands = (float*)nvg__shrink(ctx->commands, &ctx->ccommands, NVG_INIT_COMMANDS_SIZE, sizeof(float));
+	c->npoints = c->npaths = c->nverts = 0;
+	c->points = (NVGpoint*)nvg__shrink(c->points, &c->cpoints, NVG_INIT_POINTS_SIZE, sizeof(NVGpoint));
+	c->paths = (NVGpath*)nvg__shrink(c->paths, &c->cpaths, NVG_INIT_PATHS_SIZE, sizeof(NVGpath));
+	c->verts = (NVGvertex*)nvg__shrink(c->verts, &c->cverts, NVG_INIT_VERTS_SIZE, sizeof(NVGvertex));
+
+	if (!dropGlyphs) return;
+	for (i = 1; i < NVG_MAX_FONTIMAGES; i++) {
+		if (ctx->fontImages[i] != 0) {
+			nvgDeleteImage(ctx, ctx->fontImages[i]);
+			ctx->fontImages[i] = 0;
+		}
+	}
+	fonsResetAtlas(ctx->fs, NVG_FONTIMAGE_SIZE, NVG_FONTIMAGE_SIZE);
+}
+
 void nvgTextBox(NVGcontext* ctx, float x, float y, float breakRowWidth, const char* string, const char* end)
 {
 	NVGstate* state = nvg__getState(ctx);
@@ -2583,7 +2677,7 @@ int nvgTextGlyphPositions(NVGcontext* ctx, float x, float y, const char* string,
 	NVGstate* state = nvg__getState(ctx);
 	float scale = nvg__getFontScale(state) * ctx->devicePxRatio;
 	float invscale = 1.0f / scale;
-	FONStextIter iter, prevIter;
+	FONStextIter iter;
 	FONSquad q;
 	int npos = 0;
 
@@ -2602,13 +2696,7 @@ int nvgTextGlyphPositions(NVGcontext* ctx, float x, float y, const char* string,
 	fonsSetFont(ctx->fs, state->fontId);
 
 	fonsTextIterInit(ctx->fs, &iter, x*scale, y*scale, string, end, FONS_GLYPH_BITMAP_OPTIONAL);
-	prevIter = iter;
 	while (fonsTextIterNext(ctx->fs, &iter, &q)) {
-		if (iter.prevGlyphIndex < 0 && nvg__allocTextAtlas(ctx)) { // can not retrieve glyph?
-			iter = prevIter;
-			fonsTextIterNext(ctx->fs, &iter, &q); // try again
-		}
-		prevIter = iter;
 		positions[npos].str = iter.str;
 		positions[npos].x = iter.x * invscale;
 		positions[npos].minx = nvg__minf(iter.x, q.x0) * invscale;
@@ -2633,7 +2721,7 @@ int nvgTextBreakLines(NVGcontext* ctx, const char* string, const char* end, floa
 	NVGstate* state = nvg__getState(ctx);
 	float scale = nvg__getFontScale(state) * ctx->devicePxRatio;
 	float invscale = 1.0f / scale;
-	FONStextIter iter, prevIter;
+	FONStextIter iter;
 	FONSquad q;
 	int nrows = 0;
 	float rowStartX = 0;
@@ -2668,13 +2756,7 @@ int nvgTextBreakLines(NVGcontext* ctx, const char* string, const char* end, floa
 	breakRowWidth *= scale;
 
 	fonsTextIterInit(ctx->fs, &iter, 0, 0, string, end, FONS_GLYPH_BITMAP_OPTIONAL);
-	prevIter = iter;
 	while (fonsTextIterNext(ctx->fs, &iter, &q)) {
-		if (iter.prevGlyphIndex < 0 && nvg__allocTextAtlas(ctx)) { // can not retrieve glyph?
-			iter = prevIter;
-			fonsTextIterNext(ctx->fs, &iter, &q); // try again
-		}
-		prevIter = iter;
 		switch (iter.codepoint) {
 			case 9:			// \t
 			case 11:		// \v
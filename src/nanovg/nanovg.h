@@ -628,6 +628,38 @@ void nvgTextMetrics(NVGcontext* ctx, float* ascender, float* descender, float* l
 // Words longer than the max width are slit at nearest character (i.e. no hyphenation).
 int nvgTextBreakLines(NVGcontext* ctx, const char* string, const char* end, float breakRowWidth, NVGtextRow* rows, int maxRows);
 
+// Rasterizes the glyphs of the string in to the font atlas using the current font face at the
+// specified size and device pixel ratio, without drawing anything. Call it with the render
+// context current, e.g. at startup, so the first frame using those glyphs does not pay for them.
+void nvgTextPrewarm(NVGcontext* ctx, float size, float devicePixelRatio, const char* string, const char* end);
+
+// Font atlas usage counters.
+struct NVGfontAtlasStats {
+	int pages;                  // Atlas pages (textures) in use.
+	int pageWidth, pageHeight;  // Size of each page.
+	float fill;                 // Fraction of the allocated page area in use, [0..1].
+	int rasterized;             // Glyphs rasterized since the context was created.
+	int rasterizedLastFrame;    // Glyphs rasterized between the last begin and end frame.
+};
+typedef struct NVGfontAtlasStats NVGfontAtlasStats;
+
+void nvgFontAtlasStats(NVGcontext* ctx, NVGfontAtlasStats* stats);
+
+// Bytes held by the context's scratch buffers and font atlas.
+struct NVGmemoryStats {
+	int commandBytes;    // Path command buffer.
+	int pathCacheBytes;  // Flattened points, paths and vertices.
+	int atlasBytes;      // Font atlas pages in CPU memory. Their textures hold as much again.
+};
+typedef struct NVGmemoryStats NVGmemoryStats;
+
+void nvgMemoryStats(NVGcontext* ctx, NVGmemoryStats* stats);
+
+// Shrinks the scratch buffers back to their initial size and, if dropGlyphs is set, empties the
+// font atlas down to one page. Dropped glyphs are rasterized again when next drawn.
+// Call outside of a frame.
+void nvgTrimCaches(NVGcontext* ctx, int dropGlyphs);
+
 //
 // Internal Render API
 //
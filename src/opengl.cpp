@@ -14,6 +14,9 @@ namespace lui {
 
 using OpenGLContext = nvg::Context;
 
+static constexpr const char* printable_ascii =
+    " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+
 /** Surf template param must be an OpenGLView of some kind */
 template <class Ctx>
 class OpenGLView : public lui::View {
@@ -53,6 +56,8 @@ protected:
             }
 #endif
             _context = std::make_unique<context_type>();
+            // rasterize the default face up front so the first frame doesn't stall.
+            _context->prewarm (Font(), printable_ascii, { Font().height() }, scale_factor());
         }
 
         View::created();
@@ -84,6 +89,21 @@ protected:
         last_frame = frame;
     }
 
+    void add_memory_stats (MemoryStats& stats) const override {
+        if (_context)
+            _context->add_memory_stats (stats);
+    }
+
+    void trim_caches (TrimLevel level) override {
+        if (! _context)
+            return;
+        auto view = (PuglView*) c_obj();
+        if (puglEnterContext (view) != PUGL_SUCCESS)
+            return;
+        _context->trim_caches (level);
+        puglLeaveContext (view);
+    }
+
 private:
     std::unique_ptr<Ctx> _context;
     Bounds last_frame;
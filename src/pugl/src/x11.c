@@ -1527,7 +1527,16 @@ puglSendEvent(PuglView* const view, const PuglEvent* const event)
 
   xev = eventToX(view, event);
   if (xev.type) {
-    return puglX11Status(XSendEvent(display, impl->win, False, 0, &xev));
+    const PuglStatus st =
+      puglX11Status(XSendEvent(display, impl->win, False, 0, &xev));
+
+    // Client events may come from another thread to wake the event loop, so
+    // don't leave them in the output buffer
+    if (!st && event->type == PUGL_CLIENT) {
+      XFlush(display);
+    }
+
+    return st;
   }
 
   return PUGL_UNSUPPORTED;
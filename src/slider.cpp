@@ -1,11 +1,17 @@
 // Copyright 2022 Kushview, LLC
 // SPDX-License-Identifier: ISC
 
+#include <atomic>
+#include <cmath>
 #include <iostream>
 
+#include <lui/main.hpp>
 #include <lui/path.hpp>
 #include <lui/slider.hpp>
 
+#include "detail/frame.hpp"
+#include "detail/pool.hpp"
+
 namespace lui {
 
 namespace detail {
@@ -48,7 +54,7 @@ inline static void draw_dial_proto (Graphics& g, lui::Dial& dial, Rectangle<doub
         const float csf       = rw - (rw * thickness);
         {
             const float csf = rw - (rw * thickness);
-            Path filled;
+            FramePath filled (&g.frame_arena());
             filled.add_ellipse (Rectangle<float> (rx, ry, rw, rw).reduced (csf));
             g.set_color (Color (0xffffffff).darker (1.f));
             g.context().set_line_width (2.5);
@@ -79,13 +85,92 @@ inline static void draw_dial_proto (Graphics& g, lui::Dial& dial, Rectangle<doub
 
 class Ranged {
 public:
-    Ranged (lui::Ranged& o) : owner (o) {}
+    Ranged (lui::Ranged& o) : owner (o), handle (&o) {}
+
+    LUI_POOL_ALLOCATED
+
+    /** Set the value and notify from the event loop. Nothing changes on
+        the calling thread, which only touches atomics and the post queue.
+        Of several values set before the loop runs, the latest is applied
+        with one call to on_value_changed. Without a view, or with the
+        queue full, the value is held until the slider is next attached or
+        set again.
+     */
+    void set_value_async (double new_value) {
+        async_value.store (new_value, std::memory_order_relaxed);
+        if (async_pending.exchange (true))
+            return;
+
+        auto main = async_main.load (std::memory_order_acquire);
+        if (main != nullptr && main->post ([handle = handle]() {
+                if (auto self = handle.as<lui::Ranged>())
+                    self->impl->apply_async();
+            }))
+            return;
+
+        async_held.store (true, std::memory_order_relaxed);
+        async_pending.store (false);
+    }
+
+    /** Apply the latest async value. UI thread only. */
+    void apply_async() {
+        async_pending.exchange (false);
+        async_held.store (false, std::memory_order_relaxed);
+        owner.set_value (async_value.load (std::memory_order_relaxed), Notify::SYNC);
+    }
+
+    /** Look up where async values are posted. UI thread only, when the
+        slider moves between views.
+     */
+    void attached() {
+        auto view = owner.find_view();
+        async_main.store (view != nullptr ? &view->main() : nullptr, std::memory_order_release);
+        if (view != nullptr && async_held.load (std::memory_order_relaxed))
+            apply_async();
+    }
+
+    /** Start polling the bound channel once per frame. */
+    void poll_channel() {
+        version = ~uint64_t (0);
+        if (polling || channel == nullptr)
+            return;
+
+        polling       = true;
+        WidgetRef ref = &owner;
+        FrameTasks::current().add ([ref] (double) {
+            auto self = ref.as<lui::Ranged>();
+            return self != nullptr && self->impl->poll();
+        });
+    }
+
+    /** Apply the latest channel value. Returns false when unbound. */
+    bool poll() {
+        if (channel == nullptr) {
+            polling = false;
+            return false;
+        }
+
+        double latest;
+        if (channel->read (latest, version) && std::abs (latest - value) > threshold)
+            owner.set_value (latest, Notify::NONE);
+        return true;
+    }
 
 private:
     friend class lui::Ranged;
     lui::Ranged& owner;
     Range<double> range;
     double value = 0.0;
+    WidgetHandle handle; // made on the UI thread, posted by value
+    std::atomic<double> async_value { 0.0 };
+    std::atomic<bool> async_pending { false };
+    std::atomic<bool> async_held { false };
+    std::atomic<lui::Main*> async_main { nullptr };
+
+    std::shared_ptr<ValueChannel<double>> channel;
+    double threshold = 0.0;
+    uint64_t version = 0;
+    bool polling     = false;
 };
 
 class Slider {
@@ -95,6 +180,8 @@ public:
     Slider (lui::Slider& o) : owner (o) {
     }
 
+    LUI_POOL_ALLOCATED
+
     void paint (Graphics& g) {
         auto r = owner.bounds().at (0);
         owner.style().draw_slider (g, owner, r, divider);
@@ -167,6 +254,11 @@ const Range<double>& Ranged::range() const noexcept { return impl->range; }
 double Ranged::value() const noexcept { return impl->value; }
 
 void Ranged::set_value (double value, Notify notify) {
+    if (notify == Notify::ASYNC) {
+        impl->set_value_async (value);
+        return;
+    }
+
     if (impl->value == value)
         return;
 
@@ -175,17 +267,12 @@ void Ranged::set_value (double value, Notify notify) {
     resized();
     repaint();
 
-    if (notify == Notify::NONE)
-        return;
-
-    if (on_value_changed) {
-        if (notify == Notify::SYNC)
-            on_value_changed();
-        else { /* trigger async callback somehow */
-        }
-    }
+    if (notify == Notify::SYNC && on_value_changed)
+        on_value_changed();
 }
 
+void Ranged::parent_structure_changed() { impl->attached(); }
+
 void Ranged::set_range (double min, double max) {
     if (min >= max)
         return;
@@ -195,6 +282,14 @@ void Ranged::set_range (double min, double max) {
     }
 }
 
+void Ranged::bind (std::shared_ptr<ValueChannel<double>> channel, double threshold) {
+    impl->channel   = std::move (channel);
+    impl->threshold = std::max (0.0, threshold);
+    impl->poll_channel();
+}
+
+ValueChannel<double>* Ranged::bound_channel() const noexcept { return impl->channel.get(); }
+
 Slider::Slider() {
     impl = std::make_unique<detail::Slider> (*this);
 }
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: ISC
 
 #pragma once
+#include <atomic>
 #include <iostream>
 #include <string>
 
@@ -117,6 +118,7 @@ public:
         _format = PixelFormat::ARGB32;
         if (_data !=nullptr && _n_comps > 0) {
             _stride =  ((_n_comps * std::max (1, _width) + 3) & ~3);
+            count_bytes();
         } 
     }
     
@@ -125,6 +127,7 @@ public:
         _format = PixelFormat::ARGB32;
         if (_data !=nullptr && _n_comps > 0) {
             _stride =  ((_n_comps * std::max (1, _width) + 3) & ~3);
+            count_bytes();
         }
     }
 
@@ -138,6 +141,12 @@ public:
     int stride() const noexcept override { return _stride; }
     PixelFormat format() const noexcept override { return _format; }
 
+    /** Bytes held by the pixels of every instance. */
+    static std::atomic<size_t>& live_bytes() noexcept {
+        static std::atomic<size_t> bytes { 0 };
+        return bytes;
+    }
+
 private:
     uint8_t* _data { nullptr };
     PixelFormat _format;
@@ -145,12 +154,20 @@ private:
         _height { 0 },
         _n_comps { 0 },
         _stride;
+    size_t _bytes { 0 };
+
+    void count_bytes() {
+        _bytes = (size_t) _stride * (size_t) std::max (0, _height);
+        live_bytes() += _bytes;
+    }
 
     void free_data() {
         _width = _height = 0;
         if (_data)
             stbi_image_free (_data);
         _data = nullptr;
+        live_bytes() -= _bytes;
+        _bytes = 0;
     }
 };
 
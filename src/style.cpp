@@ -1,9 +1,69 @@
 // Copyright 2022 Kushview, LLC
 // SPDX-License-Identifier: ISC
 
+#include <type_traits>
+
 #include <lui/style.hpp>
 
 namespace lui {
+namespace detail {
+
+/** Where lookups on this thread are recorded, usually the widget painting. */
+static thread_local uint64_t* style_uses = nullptr;
+
+enum : int { COLOR = 0,
+             METRIC,
+             FONT };
+
+/** The bit of an entry in a uses mask. Entries share bits past 64, which
+    only costs an extra repaint.
+ */
+static inline uint64_t style_bit (int kind, int ID) noexcept {
+    return uint64_t (1) << ((unsigned) (ID + kind * 21) & 63u);
+}
+
+static inline void style_used (int kind, int ID) noexcept {
+    if (style_uses != nullptr)
+        *style_uses |= style_bit (kind, ID);
+}
+
+/** Store value at ID, growing the table. Returns false if unchanged. */
+template <class T>
+static bool style_store (StyleTable<T>& table, int ID, const T& value) {
+    if (ID < 0)
+        return false;
+
+    T* slot;
+    if (ID <= StyleTable<T>::max_flat) {
+        if ((size_t) ID >= table.flat.size())
+            table.flat.resize ((size_t) ID + 1);
+        slot = &table.flat[(size_t) ID];
+    } else {
+        slot = &table.sparse[ID];
+    }
+
+    if constexpr (std::is_same_v<T, Font>) {
+        // fonts don't compare reliably, always count as changed.
+    } else {
+        if (*slot == value)
+            return false;
+    }
+    *slot = value;
+    return true;
+}
+
+/** Returns the value at ID, or a default one if not set. */
+template <class T>
+static T style_find (const StyleTable<T>& table, int ID) {
+    if (ID < 0)
+        return T {};
+    if (ID <= StyleTable<T>::max_flat)
+        return (size_t) ID < table.flat.size() ? table.flat[(size_t) ID] : T {};
+    auto it = table.sparse.find (ID);
+    return it != table.sparse.end() ? it->second : T {};
+}
+
+} // namespace detail
 
 Style::Style() {
     _weak_status.reset (this);
@@ -14,16 +74,50 @@ Style::~Style() {
 }
 
 void Style::set_color (int ID, Color color) {
-    _colors.insert (ColorItem { ID, color });
+    if (detail::style_store (_colors, ID, color))
+        changed (detail::style_bit (detail::COLOR, ID));
 }
 
 Color Style::find_color (int ID) const noexcept {
-    if (_colors.empty())
-        return {};
-    auto it = _colors.find (ColorItem { ID, {} });
-    if (it != _colors.end())
-        return (*it).color;
-    return {};
+    detail::style_used (detail::COLOR, ID);
+    return detail::style_find (_colors, ID);
+}
+
+void Style::set_metric (int ID, float value) {
+    if (detail::style_store (_metrics, ID, value))
+        changed (detail::style_bit (detail::METRIC, ID));
+}
+
+float Style::find_metric (int ID) const noexcept {
+    detail::style_used (detail::METRIC, ID);
+    return detail::style_find (_metrics, ID);
+}
+
+void Style::set_font (int ID, const Font& font) {
+    if (detail::style_store (_fonts, ID, font))
+        changed (detail::style_bit (detail::FONT, ID));
+}
+
+Font Style::find_font (int ID) const {
+    detail::style_used (detail::FONT, ID);
+    return detail::style_find (_fonts, ID);
+}
+
+uint64_t* Style::record_uses (uint64_t* uses) noexcept {
+    auto previous      = detail::style_uses;
+    detail::style_uses = uses;
+    return previous;
+}
+
+void Style::mark_uses (uint64_t uses) noexcept {
+    if (detail::style_uses != nullptr)
+        *detail::style_uses |= uses;
+}
+
+void Style::changed (uint64_t uses) {
+    ++_version;
+    if (_changed)
+        _changed (uses);
 }
 
 } // namespace lui
@@ -24,11 +24,35 @@ View::View (lui::View& o, lui::Main& m, lui::Widget& w)
 }
 
 View::~View() {
+    realized (false);
     puglStopTimer (view, 0);
     puglFreeView (view);
     view = nullptr;
 }
 
+void View::drain_posted() {
+    main.impl->drain_posted();
+}
+
+bool View::apply_pending_bounds() {
+    if (! bounds_pending)
+        return false;
+    bounds_pending = false;
+    main.impl->begin_repaints();
+    widget.set_bounds (pending_bounds);
+    damage      = {};
+    full_damage = false;
+    main.impl->end_repaints();
+    return true;
+}
+
+void View::realized (bool is_realized) {
+    if (is_realized)
+        main.impl->set_wake_view (view);
+    else
+        main.impl->clear_wake_view (view);
+}
+
 } // namespace detail
 
 View::View (Main& m, Widget& w) {
@@ -102,6 +126,14 @@ void View::elevate (Widget& widget, ViewFlags flags) {
 }
 
 void View::repaint (Bounds area) {
+    if (impl->latency.enabled())
+        impl->latency.repaint_requested();
+
+    if (impl->main.impl->repaints_held()) {
+        impl->add_damage (area);
+        return;
+    }
+
     if (bool (LUI_DISABLE_CLIPPING) || area.empty()) {
         puglPostRedisplay (impl->view);
     } else {
@@ -110,13 +142,26 @@ void View::repaint (Bounds area) {
     }
 }
 
+bool View::start_recording (const std::string& path) { return impl->start_recording (path); }
+void View::stop_recording() { impl->stop_recording(); }
+int View::replay (const std::string& path, bool realtime) { return impl->replay (path, realtime); }
+bool View::replaying() const noexcept { return impl->replaying(); }
+
+void View::set_latency_tracking (bool enabled) { impl->latency.set_enabled (enabled); }
+bool View::latency_tracking() const noexcept { return impl->latency.enabled(); }
+const LatencyHistogram& View::latency() const noexcept { return impl->latency.histogram(); }
+bool View::live_resizing() const noexcept { return impl->live_resizing; }
+void View::reset_latency() { impl->latency.clear(); }
+
 uintptr_t View::c_obj() noexcept {
     return (uintptr_t) impl->view;
 }
 
 void View::render (DrawingContext& ctx) {
-    Graphics g (ctx);
+    auto& arena = FrameArena::current();
+    Graphics g (ctx, arena);
     impl->widget.render (g);
+    arena.reset();
 }
 
 #if 0
@@ -0,0 +1,109 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <algorithm>
+#include <cmath>
+
+#include <lui/viewport.hpp>
+
+#include "detail/pool.hpp"
+
+namespace lui {
+namespace detail {
+
+class Viewport {
+public:
+    Viewport (lui::Viewport& o) : owner (o) {}
+
+    LUI_POOL_ALLOCATED
+
+private:
+    friend class lui::Viewport;
+    lui::Viewport& owner;
+    WidgetRef content;
+    Point<int> position;
+    int step { 24 };
+
+    /** Clamp the view position and move the content to match. Returns true
+        if the content moved.
+     */
+    bool update() {
+        auto c = content.lock();
+        if (c == nullptr) {
+            position = {};
+            return false;
+        }
+
+        position.x = std::clamp (position.x, 0, std::max (0, c->width() - owner.width()));
+        position.y = std::clamp (position.y, 0, std::max (0, c->height() - owner.height()));
+
+        if (c->x() == -position.x && c->y() == -position.y)
+            return false;
+
+        c->set_bounds (-position.x, -position.y, c->width(), c->height());
+        return true;
+    }
+};
+
+} // namespace detail
+
+Viewport::Viewport() : impl (std::make_unique<detail::Viewport> (*this)) {}
+Viewport::~Viewport() { impl.reset(); }
+
+void Viewport::set_content (Widget* content) {
+    if (impl->content == content)
+        return;
+
+    if (auto old = impl->content.lock())
+        remove (old);
+
+    impl->content  = content;
+    impl->position = {};
+
+    if (content != nullptr) {
+        add (*content);
+        impl->update();
+    }
+
+    repaint();
+}
+
+Widget* Viewport::content() const noexcept { return impl->content.lock(); }
+
+void Viewport::set_view_position (int x, int y) {
+    impl->position = { x, y };
+    if (impl->update())
+        repaint();
+}
+
+Point<int> Viewport::view_position() const noexcept { return impl->position; }
+
+Bounds Viewport::view_area() const noexcept {
+    auto area = Bounds { impl->position.x, impl->position.y, width(), height() };
+    if (auto c = impl->content.lock())
+        return area.intersection (c->bounds().at (0));
+    return {};
+}
+
+void Viewport::set_scroll_step (int pixels) { impl->step = std::max (1, pixels); }
+int Viewport::scroll_step() const noexcept { return impl->step; }
+
+bool Viewport::scroll (const ScrollEvent& ev) {
+    auto delta = ev.delta;
+    if (delta.x == 0.f && ev.mods.test_flags (Modifier::SHIFT))
+        std::swap (delta.x, delta.y);
+
+    const auto before = impl->position;
+    set_view_position (before.x + static_cast<int> (std::lround (delta.x * (float) impl->step)),
+                       before.y - static_cast<int> (std::lround (delta.y * (float) impl->step)));
+    return impl->position.x != before.x || impl->position.y != before.y;
+}
+
+void Viewport::resized() { impl->update(); }
+
+void Viewport::child_size_changed (Widget* child) {
+    if (child == impl->content.lock())
+        impl->update();
+}
+
+} // namespace lui
@@ -0,0 +1,83 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <cerrno>
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+#include "detail/waker.hpp"
+
+namespace lui {
+namespace detail {
+
+Waker::Waker (std::function<void()> f) : fn (std::move (f)) {
+#ifdef _WIN32
+    event = CreateEventW (nullptr, FALSE, FALSE, nullptr);
+    if (event == nullptr)
+        return;
+#else
+    if (::pipe (fds) != 0) {
+        fds[0] = fds[1] = -1;
+        return;
+    }
+    // a full pipe already has a wake pending, so writers never block.
+    ::fcntl (fds[1], F_SETFL, ::fcntl (fds[1], F_GETFL) | O_NONBLOCK);
+#endif
+    thread = std::thread ([this]() { run(); });
+}
+
+Waker::~Waker() {
+    quit.store (true);
+    wake();
+    if (thread.joinable())
+        thread.join();
+#ifdef _WIN32
+    if (event != nullptr)
+        CloseHandle (event);
+#else
+    for (auto fd : fds)
+        if (fd >= 0)
+            ::close (fd);
+#endif
+}
+
+void Waker::wake() noexcept {
+#ifdef _WIN32
+    if (event != nullptr)
+        SetEvent (event);
+#else
+    if (fds[1] >= 0) {
+        const char byte = 1;
+        [[maybe_unused]] auto written = ::write (fds[1], &byte, 1);
+    }
+#endif
+}
+
+void Waker::run() {
+    for (;;) {
+#ifdef _WIN32
+        if (WaitForSingleObject (event, INFINITE) != WAIT_OBJECT_0)
+            return;
+#else
+        char bytes[64];
+        const auto n = ::read (fds[0], bytes, sizeof (bytes));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return;
+#endif
+        if (quit.load())
+            return;
+        fn();
+    }
+}
+
+} // namespace detail
+} // namespace lui
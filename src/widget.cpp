@@ -26,7 +26,11 @@ void Widget::release_focus() {
 }
 
 void Widget::render_internal (Graphics& g) {
-    render_all (owner, g);
+    if (render_list == nullptr)
+        render_list = std::make_unique<RenderList>();
+    if (render_list->stale (owner))
+        render_list->build (owner);
+    render_list->render (g);
 }
 
 void Widget::repaint_internal (Bounds b) {
@@ -53,6 +57,8 @@ void Widget::notify_structure_changed() {
     owner.parent_structure_changed();
 
     for (int i = (int) widgets.size(); --i >= 0;) {
+        if (widgets[i] == nullptr)
+            continue;
         widgets[i]->impl->notify_structure_changed();
         if (! ref.valid())
             return;
@@ -64,6 +70,75 @@ void Widget::notify_children_changed() {
     owner.children_changed();
 }
 
+void Widget::commit_batch() {
+    auto& b = batch();
+    // stay open while dispatching so changes made by handlers are merged.
+    ++b.depth;
+
+    std::vector<detail::Main*> mains;
+    std::vector<WidgetRef> round;
+    while (! b.widgets.empty()) {
+        round.clear();
+        std::swap (round, b.widgets);
+
+        for (auto& ref : round) {
+            auto w = ref.get();
+            if (w == nullptr)
+                continue;
+            w->impl->dispatching = w->impl->pending;
+            w->impl->pending     = 0;
+            if (auto v = w->find_view()) {
+                auto m = v->main().impl.get();
+                if (std::find (mains.begin(), mains.end(), m) == mains.end()) {
+                    m->begin_repaints();
+                    mains.push_back (m);
+                }
+            }
+        }
+
+        // a subtree is notified once, from its topmost changed widget.
+        for (auto& ref : round) {
+            auto w = ref.get();
+            if (w == nullptr || (w->impl->dispatching & STRUCTURE) == 0)
+                continue;
+            bool covered = false;
+            for (auto p = w->impl->parent; p != nullptr && ! covered; p = p->impl->parent)
+                covered = (p->impl->dispatching & STRUCTURE) != 0;
+            if (! covered)
+                w->impl->notify_structure_changed();
+        }
+
+        for (auto& ref : round)
+            if (auto w = ref.get(); w != nullptr && (w->impl->dispatching & CHILDREN) != 0)
+                w->impl->notify_children_changed();
+
+        for (auto& ref : round) {
+            auto w = ref.get();
+            if (w == nullptr)
+                continue;
+            const auto flags = w->impl->dispatching;
+            if ((flags & (MOVED | RESIZED)) != 0)
+                w->impl->notify_moved_resized ((flags & MOVED) != 0, (flags & RESIZED) != 0);
+        }
+
+        for (auto& ref : round) {
+            auto w = ref.get();
+            if (w == nullptr)
+                continue;
+            const auto flags     = w->impl->dispatching;
+            w->impl->dispatching = 0;
+            if ((flags & REPAINT) != 0)
+                w->repaint();
+            if ((flags & DAMAGE) != 0)
+                w->repaint (w->impl->pending_damage);
+        }
+    }
+
+    --b.depth;
+    for (auto m : mains)
+        m->end_repaints();
+}
+
 void Widget::notify_moved_resized (bool was_moved, bool was_resized) {
     WidgetRef ref = &owner;
     if (was_moved) {
@@ -78,6 +153,8 @@ void Widget::notify_moved_resized (bool was_moved, bool was_resized) {
             return;
 
         for (int i = (int) widgets.size(); --i >= 0;) {
+            if (widgets[i] == nullptr)
+                continue;
             widgets[i]->parent_size_changed();
             if (! ref.valid())
                 return;
@@ -92,95 +169,195 @@ void Widget::notify_moved_resized (bool was_moved, bool was_resized) {
     };
 }
 
-bool Widget::clip_widgets_blocking (const lui::Widget& w,
-                                    Graphics& g,
-                                    const Rectangle<int> cr,
-                                    Point<int> delta) {
-    int nclips = 0;
+void Widget::insert_child (lui::Widget* child) {
+    const auto z = child->impl->z_order;
+    if (widgets.empty() || (widgets.back() != nullptr && widgets.back()->impl->z_order <= z)) {
+        child->impl->index = static_cast<uint32_t> (widgets.size());
+        widgets.push_back (child);
+        return;
+    }
 
-    for (int i = w.impl->widgets.size(); --i >= 0;) {
-        auto& cw = *w.impl->widgets[i];
+    auto& list = children();
+    auto pos   = std::upper_bound (list.begin(), list.end(), z, [] (int z, const lui::Widget* w) {
+                   return z < w->impl->z_order;
+               }) - list.begin();
+    list.insert (list.begin() + pos, child);
+    for (auto i = (size_t) pos; i < list.size(); ++i)
+        list[i]->impl->index = static_cast<uint32_t> (i);
+}
 
-        if (! cw.visible())
-            continue;
+bool Widget::erase_child (lui::Widget* child) {
+    const auto i = child->impl->index;
+    if (child->impl->parent != &owner || i >= widgets.size() || widgets[i] != child)
+        return false;
 
-        auto ncr = cr.intersection (cw.bounds());
-        if (ncr.empty())
-            continue;
+    if (i + 1 == widgets.size()) {
+        widgets.pop_back();
+    } else {
+        widgets[i] = nullptr;
+        ++holes;
+    }
 
-        if (cw.opaque()) {
-            g.exclude_clip (ncr + delta);
-            ++nclips;
-        } else {
-            auto cpos = cw.pos();
-            if (clip_widgets_blocking (cw, g, ncr - cpos, cpos + delta))
-                ++nclips;
-        }
+    // squeezing out holes once they are half the list keeps removal O(1)
+    // on average without letting the list grow.
+    if (holes * 2 > widgets.size())
+        compact();
+    return true;
+}
+
+void Widget::restack_child (lui::Widget* child, bool front) {
+    auto& list      = children();
+    const auto from = (size_t) child->impl->index;
+    const auto z    = child->impl->z_order;
+    list.erase (list.begin() + (ptrdiff_t) from);
+
+    auto pos = front
+                   ? std::upper_bound (list.begin(), list.end(), z, [] (int z, const lui::Widget* w) {
+                         return z < w->impl->z_order;
+                     })
+                   : std::lower_bound (list.begin(), list.end(), z, [] (const lui::Widget* w, int z) {
+                         return w->impl->z_order < z;
+                     });
+    const auto to = (size_t) (list.insert (pos, child) - list.begin());
+    if (to == from)
+        return;
+
+    for (auto i = std::min (from, to); i <= std::max (from, to); ++i)
+        list[i]->impl->index = static_cast<uint32_t> (i);
+
+    ++generation();
+    if (child->visible())
+        child->repaint();
+}
+
+void Widget::compact() {
+    size_t count = 0;
+    for (auto w : widgets) {
+        if (w == nullptr)
+            continue;
+        w->impl->index  = static_cast<uint32_t> (count);
+        widgets[count++] = w;
     }
+    widgets.resize (count);
+    holes = 0;
+}
 
-    return nclips > 0;
+void Widget::add_memory_stats (const lui::Widget& root, MemoryStats& stats) noexcept {
+    const auto& impl = *root.impl;
+    ++stats.num_widgets;
+    stats.widgets += sizeof (Widget) + impl.widgets.capacity() * sizeof (lui::Widget*);
+    if (impl.render_list != nullptr)
+        stats.widgets += impl.render_list->memory_size();
+
+    for (auto child : impl.widgets)
+        if (child != nullptr)
+            add_memory_stats (*child, stats);
 }
 
-void Widget::render_child (lui::Widget& cw, Graphics& g) {
-    g.translate (cw.pos());
-    cw.render (g);
+void Widget::trim_render_lists (lui::Widget& root) noexcept {
+    auto& impl = *root.impl;
+    impl.render_list.reset();
+    for (auto child : impl.widgets)
+        if (child != nullptr)
+            trim_render_lists (*child);
 }
 
-void Widget::render_all (lui::Widget& widget, Graphics& g) {
-    auto& impl = *widget.impl;
-    auto cb    = g.last_clip();
+//==============================================================================
+/** Returns r moved by delta. */
+static inline Bounds shifted (Bounds r, Point<int> delta) noexcept {
+    return r.at (r.x + delta.x, r.y + delta.y);
+}
 
-    if (impl.dont_clip && impl.widgets.empty()) {
-        widget.paint (g);
-    } else {
-        ScopedSave save (g);
-        if (! (clip_widgets_blocking (widget, g, cb, {}) && g.clip_empty())) {
-            widget.paint (g);
-        }
-    }
+void RenderList::build (lui::Widget& root) {
+    _generation = Widget::generation();
+    _area       = root.bounds().at (0);
+    _entries.clear();
+    add (root, {}, _area, false);
+    occlude();
+}
+
+bool RenderList::stale (const lui::Widget& root) const noexcept {
+    return _generation != Widget::generation() || _area != root.bounds().at (0);
+}
+
+void RenderList::add (lui::Widget& widget, Point<int> origin, Bounds clip, bool clipped) {
+    auto& entry   = _entries.emplace_back();
+    entry.widget  = &widget;
+    entry.handle  = widget.handle();
+    entry.origin  = origin;
+    entry.clip    = clip;
+    entry.clipped = clipped;
+    if (widget.opaque())
+        entry.cover = widget.bounds().at (origin.x, origin.y).intersection (clip);
 
-    for (size_t i = 0; i < impl.widgets.size(); ++i) {
-        auto cw = impl.widgets[i];
+    for (auto cw : widget.impl->children()) {
         if (! cw->visible())
             continue;
+        const auto tb = shifted (cw->bounds(), origin);
+        if (! clip.intersects (tb))
+            continue;
+        if (cw->impl->dont_clip)
+            add (*cw, tb.pos(), clip, false);
+        else
+            add (*cw, tb.pos(), clip.intersection (tb), true);
+    }
+}
 
-        const auto tb = cw->bounds();
-        if (cb.intersects (tb)) {
-            ScopedSave save (g);
-
-            if (cw->impl->dont_clip) {
-                render_child (*cw, g);
-            } else {
-                g.clip (tb);
-
-                if (! g.clip_empty()) {
-                    uint32_t num_exclusions = 0;
-                    for (size_t j = i + 1; j < impl.widgets.size(); ++j) {
-                        auto sw = impl.widgets[j];
-                        if (sw->opaque() && sw->visible()) {
-                            ++num_exclusions;
-                            g.exclude_clip (sw->bounds());
-                        }
-                    }
-
-                    if (num_exclusions == 0 || ! g.clip_empty()) {
-                        render_child (*cw, g);
-                    }
-                }
-            }
+void RenderList::occlude() {
+    _mask.reset (_area);
+    size_t hidden = 0;
+    for (size_t i = _entries.size(); i-- > 0;) {
+        auto& entry = _entries[i];
+        if (_mask.covers (entry.clip)) {
+            entry.widget = nullptr;
+            ++hidden;
+        } else if (! entry.cover.empty()) {
+            _mask.add (entry.cover);
         }
     }
+
+    // keep only what gets painted.
+    if (hidden > 0)
+        std::erase_if (_entries, [] (const Entry& entry) { return entry.widget == nullptr; });
+}
+
+void RenderList::render (Graphics& g) {
+    const auto generation = Widget::generation();
+    const auto damage     = g.last_clip();
+    for (const auto& entry : _entries) {
+        // unclipped entries may paint outside their clip.
+        if (entry.clipped && ! entry.clip.intersects (damage))
+            continue;
+        // painting may delete widgets further down the list.
+        if (Widget::generation() != generation && ! entry.handle.valid())
+            continue;
+
+        ScopedSave save (g);
+        const auto local = Point<int>() - entry.origin;
+        g.translate (entry.origin);
+        if (entry.clipped)
+            g.clip (shifted (entry.clip, local));
+
+        auto& uses = entry.widget->impl->style_uses;
+        uses       = 0;
+        auto outer = Style::record_uses (&uses);
+        entry.widget->paint (g);
+        Style::record_uses (outer);
+    }
 }
 
 } // namespace detail
 
 Widget::Widget() {
-    impl = std::make_unique<detail::Widget> (*this);
+    impl    = std::make_unique<detail::Widget> (*this);
+    _handle = WidgetHandle::widgets().insert (this);
     _weak_status.reset (this);
 }
 
 Widget::~Widget() {
     _weak_status.reset (nullptr);
+    [[maybe_unused]] const bool erased = WidgetHandle::widgets().erase (_handle);
+    assert (erased); // deleted on the thread that made it
     if (auto p = parent())
         p->remove (this);
     if (impl->view)
@@ -198,21 +375,42 @@ bool Widget::visible() const noexcept { return impl->visible; }
 void Widget::set_visible (bool v) {
     if (impl->visible != v) {
         impl->visible = v;
+        ++detail::Widget::generation();
+        if (impl->parent != nullptr && detail::Widget::batching())
+            impl->parent->impl->defer_damage (impl->bounds);
         if (impl->view)
             impl->view->set_visible (visible());
+        if (impl->parent != nullptr)
+            impl->parent->child_visibility_changed (this);
     }
 }
 
 void Widget::show_all() {
-    for (auto w : impl->widgets)
+    for (auto w : impl->children())
         w->set_visible (true);
 }
 
+//=============================================================================
+Widget::UpdateBatch::UpdateBatch() { ++detail::Widget::batch().depth; }
+Widget::UpdateBatch::~UpdateBatch() { commit(); }
+
+void Widget::UpdateBatch::commit() {
+    if (! _open)
+        return;
+    _open = false;
+    if (--detail::Widget::batch().depth == 0)
+        detail::Widget::commit_batch();
+}
+
 //=============================================================================
 void Widget::repaint() {
     impl->repaint_internal (impl->bounds.at (0));
 }
 
+void Widget::repaint (Bounds area) {
+    impl->repaint_internal (area);
+}
+
 bool Widget::opaque() const noexcept { return impl->opaque; }
 
 Bounds Widget::bounds() const noexcept { return impl->bounds; }
@@ -228,11 +426,24 @@ void Widget::set_bounds (int x, int y, int w, int h) {
     const bool was_moved   = impl->bounds.x != x || impl->bounds.y != y;
     const bool was_resized = impl->bounds.width != w || impl->bounds.height != h;
 
+    // the old area in the parent needs a repaint when batched.
+    if ((was_moved || was_resized) && visible() && impl->parent != nullptr && detail::Widget::batching())
+        impl->parent->impl->defer_damage (impl->bounds);
+
     impl->bounds.x      = x;
     impl->bounds.y      = y;
     impl->bounds.width  = w;
     impl->bounds.height = h;
 
+    if (was_moved || was_resized)
+        ++detail::Widget::generation();
+
+    uint8_t flags = (was_moved ? detail::Widget::MOVED : 0) | (was_resized ? detail::Widget::RESIZED : 0);
+    if (flags != 0 && visible())
+        flags |= detail::Widget::REPAINT;
+    if (impl->defer (flags))
+        return;
+
     if (visible() && was_resized)
         repaint();
 
@@ -264,10 +475,19 @@ void Widget::add_internal (Widget* widget) {
 
     widget->impl->parent = this;
 
+    if (detail::Widget::batching()) {
+        impl->insert_child (widget);
+        ++detail::Widget::generation();
+        widget->impl->defer (detail::Widget::STRUCTURE | (widget->visible() ? detail::Widget::REPAINT : 0));
+        impl->defer (detail::Widget::CHILDREN);
+        return;
+    }
+
     if (widget->visible())
         widget->repaint();
 
-    impl->widgets.push_back (widget);
+    impl->insert_child (widget);
+    ++detail::Widget::generation();
 
     // child events
     widget->impl->notify_structure_changed();
@@ -277,12 +497,19 @@ void Widget::add_internal (Widget* widget) {
 }
 
 void Widget::remove (Widget* widget) {
-    auto it = std::find (impl->widgets.begin(), impl->widgets.end(), widget);
-    if (it == impl->widgets.end())
+    if (widget == nullptr || ! impl->erase_child (widget))
         return;
 
-    impl->widgets.erase (it);
     widget->impl->parent = nullptr;
+    ++detail::Widget::generation();
+
+    if (detail::Widget::batching()) {
+        if (widget->visible())
+            impl->defer_damage (widget->bounds());
+        widget->impl->defer (detail::Widget::STRUCTURE);
+        impl->defer (detail::Widget::CHILDREN);
+        return;
+    }
 
     // child events
     widget->impl->notify_structure_changed();
@@ -295,10 +522,56 @@ void Widget::remove (Widget& widget) {
     remove (&widget);
 }
 
+void Widget::add_all (std::span<Widget* const> widgets) {
+    UpdateBatch batch;
+    for (auto widget : widgets)
+        add_internal (widget);
+}
+
+void Widget::remove_all (std::span<Widget* const> widgets) {
+    UpdateBatch batch;
+    for (auto widget : widgets)
+        remove (widget);
+}
+
+void Widget::remove_all() {
+    UpdateBatch batch;
+    const auto children = impl->children();
+    for (auto widget : children)
+        remove (widget);
+}
+
+size_t Widget::num_children() const noexcept { return impl->num_children(); }
+
+Widget* Widget::child_at (size_t index) const noexcept {
+    auto& children = impl->children();
+    return index < children.size() ? children[index] : nullptr;
+}
+
+void Widget::set_z_order (int z) {
+    if (impl->z_order == z)
+        return;
+    impl->z_order = z;
+    if (auto p = impl->parent)
+        p->impl->restack_child (this, true);
+}
+
+int Widget::z_order() const noexcept { return impl->z_order; }
+
+void Widget::to_front() {
+    if (auto p = impl->parent)
+        p->impl->restack_child (this, true);
+}
+
+void Widget::to_back() {
+    if (auto p = impl->parent)
+        p->impl->restack_child (this, false);
+}
+
 bool Widget::obstructed (int x, int y) {
     auto pos = Point<int> { x, y }.as<float>();
 
-    for (auto child : impl->widgets) {
+    for (auto child : impl->children()) {
         if (child->visible() && detail::test_pos (*child, convert::from_parent_space (*child, pos))) {
             return true;
         }
@@ -309,7 +582,10 @@ bool Widget::obstructed (int x, int y) {
 
 Widget* Widget::widget_at (Point<float> pos) {
     if (visible() && detail::test_pos (*this, pos)) {
-        for (auto child : impl->widgets) {
+        // front to back.
+        auto& children = impl->children();
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            auto child = *it;
             if (auto c2 = child->widget_at (convert::from_parent_space (*child, pos)))
                 return c2;
         }
@@ -338,6 +614,16 @@ uintptr_t Widget::find_handle() const noexcept {
     return 0;
 }
 
+uint64_t& detail::Widget::generation() noexcept {
+    thread_local uint64_t generation = 0;
+    return generation;
+}
+
+SlotMap<Widget*>& WidgetHandle::widgets() noexcept {
+    thread_local SlotMap<Widget*> table;
+    return table;
+}
+
 Style& Widget::style() {
     if (auto v = find_view())
         return v->style();
@@ -349,6 +635,7 @@ void Widget::set_opaque (bool op) {
     if (impl->opaque == op)
         return;
     impl->opaque = op;
+    ++detail::Widget::generation();
     repaint();
 }
 
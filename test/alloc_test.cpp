@@ -0,0 +1,124 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+// Replaces the global allocator to count calls, so it builds on its own
+// and leaves every other test with the real one.
+
+#include <atomic>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include "tests.hpp"
+
+#include <lui/arena.hpp>
+#include <lui/path.hpp>
+#include <lui/widget.hpp>
+
+namespace {
+/** Calls to the global operator new while counting. */
+std::atomic<bool> counting_news { false };
+std::atomic<size_t> num_news { 0 };
+
+void* counted_new (std::size_t n, std::size_t align = 0) {
+    if (counting_news.load (std::memory_order_relaxed))
+        num_news.fetch_add (1, std::memory_order_relaxed);
+    n = std::max<std::size_t> (n, 1);
+    void* p;
+    if (align == 0)
+        p = std::malloc (n);
+    else
+#ifdef _WIN32
+        p = _aligned_malloc (n, align);
+#else
+        p = std::aligned_alloc (align, (n + align - 1) / align * align);
+#endif
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void aligned_free (void* p) noexcept {
+#ifdef _WIN32
+    _aligned_free (p);
+#else
+    std::free (p);
+#endif
+}
+} // namespace
+
+void* operator new (std::size_t n) { return counted_new (n); }
+void* operator new[] (std::size_t n) { return counted_new (n); }
+void* operator new (std::size_t n, std::align_val_t a) { return counted_new (n, static_cast<std::size_t> (a)); }
+void* operator new[] (std::size_t n, std::align_val_t a) { return counted_new (n, static_cast<std::size_t> (a)); }
+void operator delete (void* p) noexcept { std::free (p); }
+void operator delete[] (void* p) noexcept { std::free (p); }
+void operator delete (void* p, std::size_t) noexcept { std::free (p); }
+void operator delete[] (void* p, std::size_t) noexcept { std::free (p); }
+void operator delete (void* p, std::align_val_t) noexcept { aligned_free (p); }
+void operator delete[] (void* p, std::align_val_t) noexcept { aligned_free (p); }
+void operator delete (void* p, std::size_t, std::align_val_t) noexcept { aligned_free (p); }
+void operator delete[] (void* p, std::size_t, std::align_val_t) noexcept { aligned_free (p); }
+
+namespace {
+
+/** Draws nothing, everything is inside the clip. */
+class Unclipped : public NullContext {
+public:
+    lui::Bounds last_clip() const override { return { 0, 0, 100, 100 }; }
+};
+
+/** Paints paths and lists from the frame arena, like the dial. */
+class Shapes : public lui::Widget {
+public:
+    Shapes() { set_visible (true); }
+    void paint (lui::Graphics& g) override {
+        lui::FramePath path (&g.frame_arena());
+        path.add_ellipse (0.f, 0.f, 10.f, 10.f);
+        path.move_to (2.f, 2.f);
+        path.line_to (7.f, 2.f);
+        path.line_to (7.f, 7.f);
+        path.close_path();
+        g.fill_path (path);
+        std::pmr::vector<lui::Bounds> cells (&g.frame_arena());
+        for (int i = 0; i < 10; ++i)
+            cells.push_back ({ i * 5, 0, 5, 5 });
+        for (auto& r : cells)
+            g.fill_rect (r);
+        ++painted;
+    }
+    int painted = 0;
+};
+
+} // namespace
+
+TEST(Render, no_allocations_after_warm_up) {
+    Shapes root, a, b, a1;
+    root.set_bounds (0, 0, 100, 100);
+    a.set_bounds (0, 0, 50, 100);
+    b.set_bounds (40, 0, 60, 100);
+    a1.set_bounds (10, 10, 20, 20);
+    root.add (a);
+    root.add (b);
+    a.add (a1);
+
+    Unclipped ctx;
+    auto frame = [&]() {
+        auto& arena = lui::FrameArena::current();
+        lui::Graphics g (ctx, arena);
+        root.render (g);
+        arena.reset();
+    };
+
+    for (int i = 0; i < 3; ++i)
+        frame();
+
+    num_news      = 0;
+    counting_news = true;
+    for (int i = 0; i < 10; ++i)
+        frame();
+    counting_news = false;
+    EXPECT_EQ (num_news.load(), 0u);
+    EXPECT_EQ (a1.painted, 13);
+}
@@ -0,0 +1,95 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include "tests.hpp"
+
+#include <lui/animator.hpp>
+
+using lui::Animator;
+
+TEST(Animator, tween) {
+    Animator animator;
+    double value = -1.0;
+    auto id      = animator.tween (0.0, 10.0, 1.0, [&] (double v) { value = v; }, lui::easing::linear);
+    EXPECT_NE (id, 0u);
+    EXPECT_TRUE (animator.running (id));
+    EXPECT_EQ (animator.size(), 1u);
+
+    bool finished = false;
+    EXPECT_TRUE (animator.on_finished (id, [&]() { finished = true; }));
+
+    // clock starts on the first tick
+    animator.tick (5.0);
+    EXPECT_DOUBLE_EQ (value, 0.0);
+    animator.tick (5.5);
+    EXPECT_DOUBLE_EQ (value, 5.0);
+    EXPECT_FALSE (finished);
+    animator.tick (7.0);
+    EXPECT_DOUBLE_EQ (value, 10.0);
+    EXPECT_TRUE (finished);
+    EXPECT_FALSE (animator.running (id));
+    EXPECT_EQ (animator.size(), 0u);
+}
+
+TEST(Animator, easing) {
+    EXPECT_DOUBLE_EQ (lui::easing::in_quad (0.5), 0.25);
+    EXPECT_DOUBLE_EQ (lui::easing::out_quad (0.5), 0.75);
+    EXPECT_DOUBLE_EQ (lui::easing::in_out_cubic (0.5), 0.5);
+    EXPECT_DOUBLE_EQ (lui::easing::in_out_cubic (1.0), 1.0);
+}
+
+TEST(Animator, spring) {
+    Animator animator;
+    double value = 0.0;
+    auto id      = animator.spring (0.0, 1.0, [&] (double v) { value = v; });
+
+    double now = 0.0;
+    for (int i = 0; i < 600 && animator.running (id); ++i)
+        animator.tick (now += 1.0 / 60.0);
+    EXPECT_FALSE (animator.running (id));
+    EXPECT_DOUBLE_EQ (value, 1.0);
+}
+
+TEST(Animator, retarget_cancel) {
+    Animator animator;
+    double value = 0.0;
+    auto id      = animator.tween (0.0, 10.0, 1.0, [&] (double v) { value = v; }, lui::easing::linear);
+    animator.tick (0.0);
+    animator.tick (0.5);
+    EXPECT_TRUE (animator.retarget (id, 0.0));
+    animator.tick (0.6);
+    EXPECT_DOUBLE_EQ (value, 5.0);
+    animator.tick (1.1);
+    EXPECT_DOUBLE_EQ (value, 2.5);
+
+    EXPECT_TRUE (animator.cancel (id));
+    EXPECT_FALSE (animator.cancel (id));
+    EXPECT_FALSE (animator.retarget (id, 1.0));
+    animator.tick (2.0);
+    EXPECT_DOUBLE_EQ (value, 2.5);
+}
+
+TEST(Animator, widget) {
+    Animator animator;
+    auto widget = std::make_unique<lui::Widget>();
+    widget->set_bounds (0, 0, 100, 100);
+
+    auto id = animator.tween_bounds (*widget, { 100, 50, 200, 100 }, 1.0, lui::easing::linear);
+    animator.tick (0.0);
+    animator.tick (0.5);
+    EXPECT_EQ (widget->x(), 50);
+    EXPECT_EQ (widget->y(), 25);
+    EXPECT_EQ (widget->width(), 150);
+
+    // a new bounds animation replaces the running one
+    auto id2 = animator.tween_bounds (*widget, { 0, 0, 10, 10 }, 1.0);
+    EXPECT_FALSE (animator.running (id));
+    EXPECT_TRUE (animator.running (id2));
+
+    int calls = 0;
+    animator.tween (*widget, 0.0, 1.0, 1.0, [&] (double) { ++calls; });
+    widget.reset();
+    animator.tick (0.6);
+    EXPECT_EQ (calls, 0);
+    EXPECT_EQ (animator.size(), 0u);
+}
@@ -0,0 +1,54 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <cstdint>
+#include <vector>
+
+#include "tests.hpp"
+
+#include <lui/arena.hpp>
+#include <lui/path.hpp>
+
+TEST(FrameArena, reuse) {
+    lui::FrameArena arena (1024);
+    auto a = arena.allocate (100, 8);
+    auto b = arena.allocate (100, 64);
+    EXPECT_NE (a, b);
+    EXPECT_EQ (reinterpret_cast<uintptr_t> (b) % 64, 0u);
+    EXPECT_EQ (arena.stats().allocations, 2u);
+    EXPECT_EQ (arena.stats().heap_allocations, 1u);
+
+    // bigger than a chunk.
+    (void) arena.allocate (4000, 16);
+    EXPECT_EQ (arena.stats().heap_allocations, 2u);
+
+    // the next frame fits in what the last one took.
+    for (int frame = 0; frame < 3; ++frame) {
+        arena.reset();
+        EXPECT_EQ (arena.stats().allocations, 0u);
+        EXPECT_EQ (arena.allocate (100, 8), a);
+        (void) arena.allocate (100, 64);
+        (void) arena.allocate (4000, 16);
+        EXPECT_EQ (arena.stats().heap_allocations, 2u);
+    }
+
+    arena.release();
+    EXPECT_EQ (arena.stats().capacity, 0u);
+}
+
+TEST(FrameArena, containers) {
+    lui::FrameArena arena;
+    for (int frame = 0; frame < 3; ++frame) {
+        std::pmr::vector<int> ints (&arena);
+        for (int i = 0; i < 1000; ++i)
+            ints.push_back (i);
+
+        lui::FramePath path (&arena);
+        path.add_ellipse (0.f, 0.f, 10.f, 10.f);
+        EXPECT_EQ (path.data().get_allocator().resource(), &arena);
+        EXPECT_FALSE (path.data().empty());
+
+        arena.reset();
+    }
+    EXPECT_EQ (arena.stats().heap_allocations, 1u);
+}
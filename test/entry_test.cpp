@@ -0,0 +1,105 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <string>
+
+#include "tests.hpp"
+
+#include <lui/graphics.hpp>
+
+#include "detail/text_line.hpp"
+
+using lui::detail::TextLine;
+
+namespace {
+
+/** Every byte is 10 wide, "AV" kerns together by 3. */
+class Kerning : public NullContext {
+public:
+    mutable int measured = 0;
+
+    lui::TextMetrics text_metrics (std::string_view text) const noexcept override {
+        ++measured;
+        lui::TextMetrics tm;
+        tm.x_stride = 10.0 * static_cast<double> (text.size());
+        for (size_t i = 1; i < text.size(); ++i)
+            if (text[i - 1] == 'A' && text[i] == 'V')
+                tm.x_stride -= 3.0;
+        return tm;
+    }
+};
+
+} // namespace
+
+TEST(Entry, insert_erase) {
+    TextLine line;
+    EXPECT_TRUE (line.insert ("helrld"));
+    line.set_caret (3);
+    EXPECT_TRUE (line.insert ("lo wo"));
+    EXPECT_EQ (std::string (line.text().c_str()), "hello world");
+    EXPECT_EQ (line.caret(), 8u);
+
+    // control characters and broken sequences are dropped.
+    EXPECT_FALSE (line.insert ("\x01\x7f\xc3"));
+    EXPECT_EQ (line.size(), 11u);
+
+    line.erase (line.prev (line.caret()));
+    EXPECT_EQ (std::string (line.text().c_str()), "hello wrld");
+    EXPECT_EQ (line.caret(), 7u);
+
+    line.set_text ("a\xc3\xa9z");
+    EXPECT_EQ (line.caret(), 4u);
+    EXPECT_EQ (line.prev (3), 1u);
+    EXPECT_EQ (line.next (1), 3u);
+    line.set_caret (2); // inside é
+    EXPECT_EQ (line.caret(), 1u);
+    line.erase (1);
+    EXPECT_EQ (std::string (line.text().c_str()), "az");
+    line.erase (5);
+    EXPECT_EQ (line.size(), 2u);
+}
+
+TEST(Entry, caret_follows_kerning) {
+    Kerning dc;
+    TextLine line;
+    line.insert ("xAVx");
+    EXPECT_TRUE (line.needs_layout());
+    line.layout (dc);
+    EXPECT_FALSE (line.needs_layout());
+
+    EXPECT_FLOAT_EQ (line.x_of (0), 0.f);
+    EXPECT_FLOAT_EQ (line.x_of (2), 20.f);
+    EXPECT_FLOAT_EQ (line.x_of (3), 27.f);
+    EXPECT_FLOAT_EQ (line.x_of (4), 37.f);
+
+    // a second layout of the same text measures nothing.
+    const auto measured = dc.measured;
+    line.layout (dc);
+    EXPECT_EQ (dc.measured, measured);
+
+    // after an edit only positions before it are known.
+    line.set_caret (1);
+    line.insert ("V");
+    EXPECT_FLOAT_EQ (line.x_of (1), 10.f);
+    EXPECT_FLOAT_EQ (line.x_of (4), 10.f);
+    line.layout (dc);
+    EXPECT_FLOAT_EQ (line.x_of (5), 47.f);
+}
+
+TEST(Entry, caret_hit) {
+    Kerning dc;
+    TextLine line;
+    line.insert ("xAVx");
+    line.layout (dc);
+
+    EXPECT_EQ (line.hit (-5.f), 0u);
+    EXPECT_EQ (line.hit (4.f), 0u);
+    EXPECT_EQ (line.hit (6.f), 1u);
+    EXPECT_EQ (line.hit (25.f), 3u);
+    EXPECT_EQ (line.hit (22.f), 2u);
+    EXPECT_EQ (line.hit (1000.f), 4u);
+
+    line.set_caret (2);
+    line.erase (2);
+    EXPECT_EQ (line.hit (1000.f), 2u);
+}
@@ -0,0 +1,157 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <set>
+#include <vector>
+
+#include "tests.hpp"
+
+// nanovg is built into the GL backend, which the tests don't link.
+#define NVG_NO_STB
+#include "nanovg/nanovg.c"
+
+namespace {
+
+/** Keeps track of textures instead of drawing. */
+struct FakeRenderer {
+    int next_image = 1;
+    std::set<int> live;
+    std::vector<int> queued; // images sampled by this frame's draws
+    int created    = 0;
+    int deleted    = 0;
+    bool used_dead = false;
+
+    static FakeRenderer& get (void* ptr) { return *static_cast<FakeRenderer*> (ptr); }
+
+    static int create (void*) { return 1; }
+    static int create_texture (void* ptr, int, int, int, int, const unsigned char*) {
+        auto& r = get (ptr);
+        ++r.created;
+        r.live.insert (r.next_image);
+        return r.next_image++;
+    }
+    static int delete_texture (void* ptr, int image) {
+        auto& r = get (ptr);
+        ++r.deleted;
+        return r.live.erase (image) > 0 ? 1 : 0;
+    }
+    static int update_texture (void*, int, int, int, int, int, const unsigned char*) { return 1; }
+    static int texture_size (void*, int, int* w, int* h) {
+        *w = *h = NVG_FONTIMAGE_SIZE;
+        return 1;
+    }
+    static void viewport (void*, float, float, float) {}
+    static void cancel (void* ptr) { get (ptr).queued.clear(); }
+    static void flush (void* ptr) {
+        auto& r = get (ptr);
+        for (auto image : r.queued)
+            if (r.live.count (image) == 0)
+                r.used_dead = true;
+        r.queued.clear();
+    }
+    static void fill (void*, NVGpaint*, NVGcompositeOperationState, NVGscissor*, float, const float*, const NVGpath*, int) {}
+    static void stroke (void*, NVGpaint*, NVGcompositeOperationState, NVGscissor*, float, float, const NVGpath*, int) {}
+    static void triangles (void* ptr, NVGpaint* paint, NVGcompositeOperationState, NVGscissor*, const NVGvertex*, int, float) {
+        get (ptr).queued.push_back (paint->image);
+    }
+    static void destroy (void*) {}
+
+    NVGcontext* create_context() {
+        NVGparams params {};
+        params.userPtr              = this;
+        params.renderCreate         = create;
+        params.renderCreateTexture  = create_texture;
+        params.renderDeleteTexture  = delete_texture;
+        params.renderUpdateTexture  = update_texture;
+        params.renderGetTextureSize = texture_size;
+        params.renderViewport       = viewport;
+        params.renderCancel         = cancel;
+        params.renderFlush          = flush;
+        params.renderFill           = fill;
+        params.renderStroke         = stroke;
+        params.renderTriangles      = triangles;
+        params.renderDelete         = destroy;
+        return nvgCreateInternal (&params);
+    }
+};
+
+const char* const letters = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+NVGcontext* create_with_font (FakeRenderer& r) {
+    auto ctx = r.create_context();
+    if (ctx != nullptr && nvgCreateFont (ctx, "sans", LUI_TEST_FONT) < 0) {
+        nvgDeleteInternal (ctx);
+        return nullptr;
+    }
+    return ctx;
+}
+
+} // namespace
+
+TEST(FontAtlas, multi_page) {
+    FakeRenderer r;
+    auto ctx = create_with_font (r);
+    ASSERT_NE (ctx, nullptr);
+
+    auto draw = [ctx] (float last) {
+        NVGfontAtlasStats stats {};
+        nvgBeginFrame (ctx, 100.f, 100.f, 1.f);
+        nvgFontFace (ctx, "sans");
+        for (float size = 100.f; size <= last; size += 10.f) {
+            nvgFontSize (ctx, size);
+            nvgText (ctx, 0.f, 0.f, letters, nullptr);
+        }
+        nvgEndFrame (ctx);
+        nvgFontAtlasStats (ctx, &stats);
+        return stats;
+    };
+
+    float last = 100.f;
+    auto stats = draw (last);
+    while (stats.pages < 2 && last < 400.f)
+        stats = draw (last += 10.f);
+
+    // a second page was started, nothing was thrown away.
+    EXPECT_GE (stats.pages, 2);
+    EXPECT_LT (stats.pages, NVG_MAX_FONTIMAGES);
+    EXPECT_EQ (r.created, stats.pages);
+    EXPECT_EQ (r.deleted, 0);
+    EXPECT_FALSE (r.used_dead);
+
+    // glyphs on every page are still cached.
+    const auto rasterized = stats.rasterized;
+    stats                 = draw (last);
+    EXPECT_EQ (stats.rasterizedLastFrame, 0);
+    EXPECT_EQ (stats.rasterized, rasterized);
+
+    nvgDeleteInternal (ctx);
+    EXPECT_TRUE (r.live.empty());
+}
+
+TEST(FontAtlas, reset_waits_for_end_of_frame) {
+    FakeRenderer r;
+    auto ctx = create_with_font (r);
+    ASSERT_NE (ctx, nullptr);
+
+    // fill every page and overflow, all in one frame.
+    nvgBeginFrame (ctx, 100.f, 100.f, 1.f);
+    nvgFontFace (ctx, "sans");
+    for (float size = 100.f; r.created <= NVG_MAX_FONTIMAGES && size < 1000.f; size += 10.f) {
+        nvgFontSize (ctx, size);
+        nvgText (ctx, 0.f, 0.f, letters, nullptr);
+    }
+    ASSERT_GT (r.created, NVG_MAX_FONTIMAGES);
+
+    // the old pages are still alive for the draws queued before the reset.
+    EXPECT_EQ (r.deleted, 0);
+    nvgEndFrame (ctx);
+    EXPECT_FALSE (r.used_dead);
+    EXPECT_EQ (r.deleted, NVG_MAX_FONTIMAGES);
+
+    NVGfontAtlasStats stats {};
+    nvgFontAtlasStats (ctx, &stats);
+    EXPECT_EQ ((int) r.live.size(), stats.pages);
+
+    nvgDeleteInternal (ctx);
+    EXPECT_TRUE (r.live.empty());
+}
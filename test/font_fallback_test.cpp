@@ -0,0 +1,175 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include "tests.hpp"
+
+#include <lui/font.hpp>
+
+#include "detail/glyph_coverage.hpp"
+
+using lui::detail::GlyphCoverage;
+
+namespace {
+
+void put16 (std::vector<uint8_t>& v, uint32_t x) {
+    v.push_back (uint8_t (x >> 8));
+    v.push_back (uint8_t (x));
+}
+
+void put32 (std::vector<uint8_t>& v, uint32_t x) {
+    put16 (v, x >> 16);
+    put16 (v, x & 0xffff);
+}
+
+/** Minimal sfnt with a single cmap subtable. */
+std::vector<uint8_t> make_font (uint32_t platform, uint32_t encoding, const std::vector<uint8_t>& subtable) {
+    std::vector<uint8_t> v;
+    put32 (v, 0x00010000);
+    put16 (v, 1);
+    put16 (v, 0);
+    put16 (v, 0);
+    put16 (v, 0);
+    put32 (v, 0x636d6170); // 'cmap'
+    put32 (v, 0);
+    put32 (v, 28);
+    put32 (v, uint32_t (12 + subtable.size()));
+
+    put16 (v, 0);
+    put16 (v, 1);
+    put16 (v, platform);
+    put16 (v, encoding);
+    put32 (v, 12);
+    v.insert (v.end(), subtable.begin(), subtable.end());
+    return v;
+}
+
+/** Format 4 mapping first..last plus the required 0xFFFF segment. */
+std::vector<uint8_t> format4 (uint32_t first, uint32_t last) {
+    std::vector<uint8_t> v;
+    put16 (v, 4);
+    put16 (v, 32);
+    put16 (v, 0);
+    put16 (v, 4); // seg count x2
+    put16 (v, 0);
+    put16 (v, 0);
+    put16 (v, 0);
+    put16 (v, last);
+    put16 (v, 0xFFFF);
+    put16 (v, 0);
+    put16 (v, first);
+    put16 (v, 0xFFFF);
+    put16 (v, (1 - first) & 0xFFFF);
+    put16 (v, 1);
+    put16 (v, 0);
+    put16 (v, 0);
+    return v;
+}
+
+std::vector<uint8_t> format12 (uint32_t first, uint32_t last) {
+    std::vector<uint8_t> v;
+    put16 (v, 12);
+    put16 (v, 0);
+    put32 (v, 28);
+    put32 (v, 0);
+    put32 (v, 1);
+    put32 (v, first);
+    put32 (v, last);
+    put32 (v, 5);
+    return v;
+}
+
+class BytesFace final : public lui::Typeface {
+public:
+    BytesFace (std::vector<uint8_t> b) : bytes (std::move (b)) {}
+    std::string name() const noexcept override { return "bytes"; }
+    const uint8_t* data() const noexcept override { return bytes.data(); }
+    size_t size() const noexcept override { return bytes.size(); }
+
+private:
+    std::vector<uint8_t> bytes;
+};
+
+} // namespace
+
+TEST(GlyphCoverage, add_contains) {
+    GlyphCoverage cov;
+    EXPECT_TRUE (cov.empty());
+    cov.add ('a');
+    cov.add ('a');
+    cov.add (0x1F600);
+    EXPECT_EQ (cov.size(), 2u);
+    EXPECT_TRUE (cov.contains ('a'));
+    EXPECT_FALSE (cov.contains ('b'));
+    EXPECT_TRUE (cov.contains (0x1F600));
+    EXPECT_FALSE (cov.contains (0x1F601));
+    EXPECT_FALSE (cov.contains (0x110000));
+}
+
+TEST(GlyphCoverage, format4) {
+    auto font = make_font (3, 1, format4 ('A', 'C'));
+    auto cov  = GlyphCoverage::from_font (font.data(), font.size());
+    EXPECT_EQ (cov.size(), 3u);
+    EXPECT_TRUE (cov.contains ('A'));
+    EXPECT_TRUE (cov.contains ('C'));
+    EXPECT_FALSE (cov.contains ('D'));
+    EXPECT_FALSE (cov.contains (0xFFFF));
+}
+
+TEST(GlyphCoverage, format12) {
+    auto font = make_font (3, 10, format12 (0x1F600, 0x1F602));
+    auto cov  = GlyphCoverage::from_font (font.data(), font.size());
+    EXPECT_EQ (cov.size(), 3u);
+    EXPECT_TRUE (cov.contains (0x1F601));
+    EXPECT_FALSE (cov.contains (0x1F603));
+}
+
+TEST(GlyphCoverage, truncated) {
+    auto font = make_font (3, 1, format4 ('A', 'C'));
+    for (size_t n = 0; n < font.size(); ++n)
+        EXPECT_LE (GlyphCoverage::from_font (font.data(), n).size(), 3u);
+}
+
+TEST(FontFallback, resolve_and_runs) {
+    lui::FontFallback chain;
+    EXPECT_TRUE (chain.empty());
+    EXPECT_EQ (chain.resolve ('A'), -1);
+
+    chain.add (std::make_shared<BytesFace> (make_font (3, 1, format4 ('A', 'C'))));
+    chain.add (std::make_shared<BytesFace> (make_font (3, 10, format12 (0x1F600, 0x1F602))));
+    chain.add (std::make_shared<BytesFace> (make_font (3, 1, format4 ('A', 'Z'))));
+    EXPECT_EQ (chain.size(), 3u);
+
+    EXPECT_EQ (chain.resolve ('B'), 0);
+    EXPECT_EQ (chain.resolve ('X'), 2);
+    EXPECT_EQ (chain.resolve (0x1F600), 1);
+    EXPECT_EQ (chain.resolve ('!'), -1);
+
+    // "AB😀XY!" -> [AB][😀][XY][!]
+    const std::string text = "AB\xF0\x9F\x98\x80XY!";
+    const auto& runs       = chain.runs (text);
+    ASSERT_EQ (runs.size(), 4u);
+    EXPECT_EQ (runs[0].start, 0u);
+    EXPECT_EQ (runs[0].length, 2u);
+    EXPECT_EQ (runs[0].face, 0);
+    EXPECT_EQ (runs[1].start, 2u);
+    EXPECT_EQ (runs[1].length, 4u);
+    EXPECT_EQ (runs[1].face, 1);
+    EXPECT_EQ (runs[2].length, 2u);
+    EXPECT_EQ (runs[2].face, 2);
+    EXPECT_EQ (runs[3].face, -1);
+
+    // cached per string
+    EXPECT_EQ (&chain.runs (text), &runs);
+}
+
+TEST(FontFallback, font) {
+    lui::FontFallback chain;
+    chain.add (std::make_shared<BytesFace> (make_font (3, 1, format4 ('A', 'C'))));
+
+    auto f = lui::Font().with_fallback (chain);
+    EXPECT_EQ (f.fallback(), chain);
+    EXPECT_EQ (f.with_height (20.f).fallback().size(), 1u);
+    EXPECT_TRUE (lui::Font().fallback().empty());
+    EXPECT_EQ (lui::Font().fallback().runs ("abc").size(), 1u);
+    EXPECT_FALSE (f == lui::Font());
+}
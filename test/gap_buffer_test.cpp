@@ -0,0 +1,63 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include "tests.hpp"
+
+#include "detail/gap_buffer.hpp"
+
+using lui::detail::GapBuffer;
+
+TEST(GapBuffer, insert_erase) {
+    GapBuffer buf;
+    EXPECT_TRUE (buf.empty());
+
+    buf.insert (0, "world");
+    buf.insert (0, "hello ");
+    EXPECT_EQ (buf.text(), "hello world");
+    EXPECT_EQ (buf.size(), 11u);
+
+    buf.insert (5, ",");
+    EXPECT_EQ (buf.text(), "hello, world");
+    EXPECT_EQ (buf[5], ',');
+    EXPECT_EQ (buf[7], 'w');
+
+    buf.erase (5, 1);
+    EXPECT_EQ (buf.text(), "hello world");
+
+    buf.erase (5, 100);
+    EXPECT_EQ (buf.text(), "hello");
+
+    buf.erase (10, 1);
+    EXPECT_EQ (buf.text(), "hello");
+
+    buf.clear();
+    EXPECT_TRUE (buf.empty());
+    EXPECT_EQ (buf.text(), "");
+}
+
+TEST(GapBuffer, moves_gap_and_grows) {
+    GapBuffer buf;
+    std::string expected;
+
+    for (int i = 0; i < 500; ++i) {
+        const auto pos = static_cast<size_t> ((i * 7) % (expected.size() + 1));
+        const char c   = static_cast<char> ('a' + (i % 26));
+        buf.insert (pos, std::string_view (&c, 1));
+        expected.insert (pos, 1, c);
+    }
+
+    EXPECT_EQ (buf.text(), expected);
+
+    char head[4] = { 0 };
+    buf.copy (0, 3, head);
+    EXPECT_EQ (std::string (head), expected.substr (0, 3));
+}
+
+TEST(GapBuffer, utf8_sequence_length) {
+    using lui::detail::utf8::sequence_length;
+    EXPECT_EQ (sequence_length ('a'), 1u);
+    EXPECT_EQ (sequence_length (0xC3), 2u);
+    EXPECT_EQ (sequence_length (0xE2), 3u);
+    EXPECT_EQ (sequence_length (0xF0), 4u);
+    EXPECT_EQ (sequence_length (0x80), 0u);
+}
@@ -0,0 +1,81 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <filesystem>
+
+#include "tests.hpp"
+
+#include "detail/input_record.hpp"
+
+using lui::detail::InputRecord;
+using lui::detail::InputRecorder;
+namespace input_file = lui::detail::input_file;
+
+TEST(InputRecord, encode_decode) {
+    InputRecord r;
+    r.time    = 1.25;
+    r.type    = InputRecord::SCROLL;
+    r.flags   = 2;
+    r.state   = 0x11;
+    r.code    = 4;
+    r.keycode = 0xdeadbeef;
+    r.x       = 12.5f;
+    r.y       = -3.f;
+    r.dx      = 0.5f;
+    r.dy      = -1.f;
+    std::memcpy (r.text, "\xC3\xA9", 3);
+
+    uint8_t bytes[InputRecord::encoded_size];
+    r.encode (bytes);
+    EXPECT_EQ (bytes[8], InputRecord::SCROLL);
+    EXPECT_EQ (bytes[18], 0xef); // little-endian
+
+    const auto d = InputRecord::decode (bytes);
+    EXPECT_DOUBLE_EQ (d.time, 1.25);
+    EXPECT_EQ (d.type, InputRecord::SCROLL);
+    EXPECT_EQ (d.flags, 2);
+    EXPECT_EQ (d.state, 0x11u);
+    EXPECT_EQ (d.code, 4u);
+    EXPECT_EQ (d.keycode, 0xdeadbeefu);
+    EXPECT_FLOAT_EQ (d.x, 12.5f);
+    EXPECT_FLOAT_EQ (d.y, -3.f);
+    EXPECT_FLOAT_EQ (d.dx, 0.5f);
+    EXPECT_FLOAT_EQ (d.dy, -1.f);
+    EXPECT_STREQ (d.text, "\xC3\xA9");
+}
+
+TEST(InputRecord, file) {
+    const auto path = (std::filesystem::temp_directory_path() / "lui-input-record-test.luir").string();
+
+    InputRecorder rec;
+    ASSERT_TRUE (rec.open (path));
+    EXPECT_TRUE (rec.recording());
+    for (int i = 0; i < 10; ++i) {
+        InputRecord r;
+        r.type = InputRecord::MOTION;
+        r.x    = (float) i;
+        rec.write (r);
+    }
+    rec.close();
+    EXPECT_FALSE (rec.recording());
+
+    std::vector<InputRecord> records;
+    ASSERT_TRUE (input_file::read (path, records));
+    ASSERT_EQ (records.size(), 10u);
+    for (size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ (records[i].type, InputRecord::MOTION);
+        EXPECT_FLOAT_EQ (records[i].x, (float) i);
+        if (i > 0) {
+            EXPECT_GE (records[i].time, records[i - 1].time);
+        }
+    }
+
+    // not a recording
+    {
+        std::ofstream out (path, std::ios::binary | std::ios::trunc);
+        out << "not a recording";
+    }
+    EXPECT_FALSE (input_file::read (path, records));
+    EXPECT_FALSE (input_file::read (path + ".missing", records));
+    std::filesystem::remove (path);
+}
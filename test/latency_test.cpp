@@ -0,0 +1,144 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <vector>
+
+#include "tests.hpp"
+
+#include <lui/latency.hpp>
+
+#include "detail/frame_latency.hpp"
+#include "detail/presenter.hpp"
+
+using lui::LatencyHistogram;
+using lui::detail::FrameLatency;
+using lui::detail::Presenter;
+
+TEST(LatencyHistogram, basics) {
+    LatencyHistogram h;
+    EXPECT_EQ (h.count(), 0u);
+    EXPECT_DOUBLE_EQ (h.mean(), 0.0);
+    EXPECT_DOUBLE_EQ (h.percentile (0.5), 0.0);
+
+    for (int i = 0; i < 90; ++i)
+        h.add (0.0045);
+    for (int i = 0; i < 9; ++i)
+        h.add (0.0205);
+    h.add (0.5);
+
+    EXPECT_EQ (h.count(), 100u);
+    EXPECT_EQ (h.bucket (4), 90u);
+    EXPECT_EQ (h.bucket (20), 9u);
+    EXPECT_EQ (h.bucket (LatencyHistogram::num_buckets - 1), 1u);
+    EXPECT_EQ (h.bucket (-1), 0u);
+    EXPECT_DOUBLE_EQ (h.min(), 0.0045);
+    EXPECT_DOUBLE_EQ (h.max(), 0.5);
+    EXPECT_NEAR (h.mean(), (90 * 0.0045 + 9 * 0.0205 + 0.5) / 100.0, 1e-12);
+
+    EXPECT_DOUBLE_EQ (h.percentile (0.5), 0.005);
+    EXPECT_DOUBLE_EQ (h.percentile (0.9), 0.005);
+    EXPECT_DOUBLE_EQ (h.percentile (0.95), 0.021);
+    EXPECT_DOUBLE_EQ (h.percentile (1.0), 0.5);
+
+    h.clear();
+    EXPECT_EQ (h.count(), 0u);
+    EXPECT_EQ (h.bucket (4), 0u);
+}
+
+namespace {
+/** Stands in for a view: a backend that logs leave() and a clock. */
+struct FakeView {
+    FrameLatency latency;
+    double time { 0.0 };
+    std::vector<const char*> calls;
+    Presenter presenter;
+    PuglBackend base {};
+    PuglViewImpl view {};
+
+    FakeView() {
+        base.leave = [] (PuglView* v, const PuglExposeEvent* expose) {
+            static_cast<FakeView*> (v->handle)->calls.push_back (expose != nullptr ? "swap" : "leave");
+            return PUGL_SUCCESS;
+        };
+        presenter.wrap (&base, &FakeView::presented, this);
+        view.backend = &presenter.backend;
+        view.handle  = this;
+        latency.set_enabled (true);
+    }
+
+    static void presented (void* data) {
+        auto self = static_cast<FakeView*> (data);
+        self->calls.push_back ("presented");
+        self->latency.presented (self->time);
+    }
+
+    /** Handle input arriving now that requests a repaint. */
+    void input() {
+        latency.set_input (time);
+        latency.repaint_requested();
+        latency.set_input (-1.0);
+    }
+
+    /** Draw a frame, as the expose handler then pugl would. */
+    void frame (double draw_time, double present_time) {
+        time = draw_time;
+        latency.exposed();
+        time               = present_time;
+        PuglExposeEvent ev = {};
+        ev.type            = PUGL_EXPOSE;
+        EXPECT_EQ (presenter.backend.leave (&view, &ev), PUGL_SUCCESS);
+    }
+};
+} // namespace
+
+TEST(FrameLatency, sampled_after_present) {
+    FakeView v;
+    v.time = 1.0;
+    v.input();
+    v.time = 1.001;
+    v.input(); // the earliest input waiting counts
+
+    v.time = 1.002;
+    v.latency.exposed();
+    EXPECT_EQ (v.latency.histogram().count(), 0u);
+
+    // leaving the context without a frame isn't a present.
+    ASSERT_EQ (v.presenter.backend.leave (&v.view, nullptr), PUGL_SUCCESS);
+    EXPECT_EQ (v.latency.histogram().count(), 0u);
+
+    v.time             = 1.010;
+    PuglExposeEvent ev = {};
+    ASSERT_EQ (v.presenter.backend.leave (&v.view, &ev), PUGL_SUCCESS);
+    ASSERT_EQ (v.calls.size(), 3u);
+    EXPECT_STREQ (v.calls[1], "swap");
+    EXPECT_STREQ (v.calls[2], "presented");
+    EXPECT_EQ (v.latency.histogram().count(), 1u);
+    EXPECT_NEAR (v.latency.histogram().max(), 0.010, 1e-9);
+
+    // frames without input add nothing.
+    v.frame (1.020, 1.030);
+    EXPECT_EQ (v.latency.histogram().count(), 1u);
+
+    v.time = 2.0;
+    v.input();
+    v.frame (2.004, 2.016);
+    EXPECT_EQ (v.latency.histogram().count(), 2u);
+    EXPECT_NEAR (v.latency.histogram().max(), 0.016, 1e-9);
+}
+
+TEST(FrameLatency, disabled_or_cleared) {
+    FakeView v;
+    v.time = 1.0;
+    v.input();
+    v.latency.set_enabled (false);
+    v.frame (1.002, 1.005);
+    EXPECT_EQ (v.latency.histogram().count(), 0u);
+
+    v.latency.set_enabled (true);
+    v.time = 2.0;
+    v.input();
+    v.frame (2.002, 2.005);
+    EXPECT_EQ (v.latency.histogram().count(), 1u);
+    v.latency.clear();
+    EXPECT_EQ (v.latency.histogram().count(), 0u);
+}
@@ -0,0 +1,223 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include "tests.hpp"
+
+#include <lui/layout.hpp>
+
+using lui::Bounds;
+
+#define EXPECT_BOUNDS(b, X, Y, W, H) \
+    EXPECT_EQ ((b).x, X);            \
+    EXPECT_EQ ((b).y, Y);            \
+    EXPECT_EQ ((b).width, W);        \
+    EXPECT_EQ ((b).height, H)
+
+namespace {
+
+class Counted : public lui::Widget {
+public:
+    int resizes = 0;
+
+protected:
+    void resized() override { ++resizes; }
+};
+
+/** Widgets start hidden, and layouts skip hidden items. */
+void show (std::initializer_list<lui::Widget*> widgets) {
+    for (auto w : widgets)
+        w->set_visible (true);
+}
+
+} // namespace
+
+TEST(FlexBox, grow) {
+    lui::FlexBox box;
+    lui::Widget a, b, c;
+    show ({ &a, &b, &c });
+    box.set_gap (10);
+    box.add (a, { .basis = 50 });
+    box.add (b, { .grow = 1.f });
+    box.add (c, { .grow = 3.f, .max_size = 100 });
+    EXPECT_EQ (box.num_items(), 3u);
+
+    box.set_bounds (0, 0, 370, 40);
+    EXPECT_BOUNDS (a.bounds(), 0, 0, 50, 40);
+    EXPECT_BOUNDS (b.bounds(), 60, 0, 200, 40);
+    EXPECT_BOUNDS (c.bounds(), 270, 0, 100, 40);
+}
+
+TEST(FlexBox, shrink) {
+    lui::FlexBox box;
+    lui::Widget a, b;
+    show ({ &a, &b });
+    box.set_direction (lui::FlexBox::COLUMN);
+    box.add (a, { .basis = 100 });
+    box.add (b, { .basis = 300, .min_size = 280 });
+
+    box.set_bounds (0, 0, 20, 300);
+    EXPECT_BOUNDS (a.bounds(), 0, 0, 20, 20);
+    EXPECT_BOUNDS (b.bounds(), 0, 20, 20, 280);
+}
+
+TEST(FlexBox, justify_align) {
+    lui::FlexBox box;
+    lui::Widget a, b;
+    show ({ &a, &b });
+    box.set_padding (5);
+    box.set_justify (lui::FlexBox::SPACE_BETWEEN);
+    box.set_align (lui::FlexBox::ALIGN_CENTER);
+    box.add (a, { .basis = 20, .cross_size = 10 });
+    box.add (b, { .basis = 20 });
+
+    box.set_bounds (0, 0, 110, 30);
+    EXPECT_BOUNDS (a.bounds(), 5, 10, 20, 10);
+    EXPECT_BOUNDS (b.bounds(), 85, 5, 20, 20);
+
+    box.set_justify (lui::FlexBox::CENTER);
+    EXPECT_BOUNDS (a.bounds(), 35, 10, 20, 10);
+    EXPECT_BOUNDS (b.bounds(), 55, 5, 20, 20);
+}
+
+TEST(FlexBox, cache) {
+    lui::FlexBox box;
+    lui::Widget a;
+    show ({ &a });
+    box.add (a, { .grow = 1.f });
+
+    const auto& first = box.solve (100, 10);
+    EXPECT_EQ (&box.solve (100, 10), &first);
+    EXPECT_EQ (first[0].width, 100);
+    EXPECT_EQ (box.solve (200, 10)[0].width, 200);
+    EXPECT_EQ (&box.solve (100, 10), &first);
+}
+
+TEST(FlexBox, remove_and_nested) {
+    lui::FlexBox outer;
+    lui::FlexBox inner;
+    lui::Widget a;
+    Counted b;
+    show ({ &inner, &a, &b });
+    outer.add (inner, { .grow = 1.f });
+    outer.add (a, { .basis = 50 });
+    inner.add (b, { .grow = 1.f });
+
+    outer.set_bounds (0, 0, 150, 20);
+    EXPECT_BOUNDS (inner.bounds(), 0, 0, 100, 20);
+    EXPECT_BOUNDS (b.bounds(), 0, 0, 100, 20);
+    const auto resizes = b.resizes;
+
+    // same size for the inner box, nothing under it is laid out again
+    outer.set_bounds (10, 10, 150, 20);
+    EXPECT_EQ (b.resizes, resizes);
+
+    outer.remove (a);
+    EXPECT_EQ (outer.num_items(), 1u);
+    EXPECT_BOUNDS (inner.bounds(), 0, 0, 150, 20);
+    EXPECT_BOUNDS (b.bounds(), 0, 0, 150, 20);
+}
+
+TEST(Grid, tracks_and_spans) {
+    lui::Grid grid;
+    lui::Widget a, b, c, d;
+    show ({ &a, &b, &c, &d });
+    grid.set_gap (10);
+    grid.set_columns ({ lui::GridTrack::pixels (40), lui::GridTrack::share(), lui::GridTrack::share (2.f) });
+    grid.set_rows ({ lui::GridTrack::pixels (20), lui::GridTrack::share() });
+    grid.add (a, 0, 0);
+    grid.add (b, 1, 0, 2);
+    grid.add (c, 0, 1, 3, 1);
+    grid.add (d, 5, 5);
+
+    grid.set_bounds (0, 0, 200, 100);
+    EXPECT_BOUNDS (a.bounds(), 0, 0, 40, 20);
+    EXPECT_BOUNDS (b.bounds(), 50, 0, 150, 20);
+    EXPECT_BOUNDS (c.bounds(), 0, 30, 200, 70);
+    EXPECT_TRUE (d.bounds().empty());
+}
+
+TEST(FlexBox, hidden_items) {
+    lui::FlexBox box;
+    lui::Widget a, b, c;
+    show ({ &a, &b, &c });
+    box.set_gap (10);
+    box.add (a, { .grow = 1.f });
+    box.add (b, { .basis = 30 });
+    box.add (c, { .grow = 1.f });
+
+    box.set_bounds (0, 0, 130, 20);
+    EXPECT_BOUNDS (a.bounds(), 0, 0, 40, 20);
+    EXPECT_BOUNDS (b.bounds(), 50, 0, 30, 20);
+    EXPECT_BOUNDS (c.bounds(), 90, 0, 40, 20);
+
+    // hidden items take no space and keep their bounds
+    b.set_visible (false);
+    EXPECT_BOUNDS (a.bounds(), 0, 0, 60, 20);
+    EXPECT_BOUNDS (b.bounds(), 50, 0, 30, 20);
+    EXPECT_BOUNDS (c.bounds(), 70, 0, 60, 20);
+
+    b.set_visible (true);
+    EXPECT_BOUNDS (a.bounds(), 0, 0, 40, 20);
+    EXPECT_BOUNDS (c.bounds(), 90, 0, 40, 20);
+}
+
+TEST(FlexBox, widget_add) {
+    lui::FlexBox box;
+    lui::Widget a, b, c;
+    show ({ &a, &b, &c });
+    box.add (a, { .basis = 20 });
+    lui::Widget* rest[] = { &b, &c };
+    box.add_all (rest);
+    EXPECT_EQ (box.num_items(), 3u);
+
+    box.set_item (c, { .grow = 1.f });
+    box.set_bounds (0, 0, 100, 10);
+    EXPECT_BOUNDS (a.bounds(), 0, 0, 20, 10);
+    EXPECT_BOUNDS (b.bounds(), 20, 0, 0, 10);
+    EXPECT_BOUNDS (c.bounds(), 20, 0, 80, 10);
+
+    box.remove (b);
+    box.add (b);
+    EXPECT_EQ (box.num_items(), 3u);
+}
+
+TEST(FlexBox, add_again_updates_item) {
+    lui::FlexBox box;
+    lui::Widget a, b;
+    show ({ &a, &b });
+    box.add (a);
+    box.add (b);
+    box.add (a, { .basis = 30 });
+    box.add (b, { .grow = 1.f });
+    EXPECT_EQ (box.num_items(), 2u);
+
+    box.set_bounds (0, 0, 100, 10);
+    EXPECT_BOUNDS (a.bounds(), 0, 0, 30, 10);
+    EXPECT_BOUNDS (b.bounds(), 30, 0, 70, 10);
+}
+
+TEST(Grid, hidden_and_widget_add) {
+    lui::Grid grid;
+    lui::Widget a, b, c;
+    show ({ &a, &b, &c });
+    grid.set_columns ({ lui::GridTrack::share(), lui::GridTrack::share() });
+    grid.set_rows ({ lui::GridTrack::share(), lui::GridTrack::share() });
+    grid.add (a, 0, 0);
+    grid.add (b);
+    grid.add (c);
+    EXPECT_EQ (grid.num_items(), 3u);
+
+    grid.set_bounds (0, 0, 100, 100);
+    EXPECT_BOUNDS (a.bounds(), 0, 0, 50, 50);
+    EXPECT_BOUNDS (b.bounds(), 50, 0, 50, 50);
+    EXPECT_BOUNDS (c.bounds(), 0, 50, 50, 50);
+
+    c.set_visible (false);
+    EXPECT_BOUNDS (c.bounds(), 0, 50, 50, 50);
+    EXPECT_TRUE (grid.solve (100, 100)[2].empty());
+
+    // adding again moves the item.
+    grid.add (b, 1, 1);
+    EXPECT_EQ (grid.num_items(), 3u);
+    EXPECT_BOUNDS (b.bounds(), 50, 50, 50, 50);
+}
@@ -0,0 +1,150 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include "tests.hpp"
+
+#include <lui/list_view.hpp>
+
+#include "detail/prefix_sum.hpp"
+
+namespace {
+
+class RowWidget : public lui::Widget {
+public:
+    int row = -1;
+    bool obstructed (int, int) override { return true; }
+};
+
+class Model : public lui::ListModel {
+public:
+    int rows                   = 100000;
+    int tall_every             = 0;
+    mutable int height_queries = 0;
+    int created                = 0;
+    int updates                = 0;
+
+    int num_rows() const override { return rows; }
+
+    int row_height (int row) const override {
+        ++height_queries;
+        return tall_every > 0 && row % tall_every == 0 ? 50 : 20;
+    }
+
+    std::unique_ptr<lui::Widget> create_row() override {
+        ++created;
+        return std::make_unique<RowWidget>();
+    }
+
+    void update_row (lui::Widget& w, int row) override {
+        ++updates;
+        static_cast<RowWidget&> (w).row = row;
+    }
+};
+
+class TestList : public lui::ListView {
+public:
+    using lui::ListView::scroll;
+};
+
+} // namespace
+
+TEST(PrefixSum, sum_and_find) {
+    lui::detail::PrefixSum<int> ps;
+    EXPECT_EQ (ps.size(), 0u);
+    EXPECT_EQ (ps.find (10), 0u);
+
+    std::vector<int> values { 3, 0, 5, 2, 7, 1, 4 };
+    ps.assign (values);
+    EXPECT_EQ (ps.size(), values.size());
+
+    int total = 0;
+    for (size_t i = 0; i <= values.size(); ++i) {
+        EXPECT_EQ (ps.sum (i), total);
+        if (i < values.size())
+            total += values[i];
+    }
+    EXPECT_EQ (ps.total(), 22);
+
+    EXPECT_EQ (ps.find (0), 0u);
+    EXPECT_EQ (ps.find (2), 0u);
+    EXPECT_EQ (ps.find (3), 2u); // skips the empty value
+    EXPECT_EQ (ps.find (8), 3u);
+    EXPECT_EQ (ps.find (21), 6u);
+    EXPECT_EQ (ps.find (22), 7u);
+
+    ps.add (1, 4);
+    EXPECT_EQ (ps.find (3), 1u);
+    EXPECT_EQ (ps.sum (3), 12);
+    EXPECT_EQ (ps.total(), 26);
+}
+
+TEST(ListView, recycles_rows) {
+    Model model;
+    TestList list;
+    list.set_bounds (0, 0, 200, 100);
+    list.set_visible (true);
+    list.set_model (&model);
+
+    EXPECT_EQ (list.num_rows(), 100000);
+    EXPECT_EQ (list.content_height(), 100000 * 20);
+    EXPECT_EQ (list.num_row_widgets(), 5);
+    EXPECT_EQ (model.updates, 5);
+    ASSERT_NE (list.row_widget (4), nullptr);
+    EXPECT_EQ (list.row_widget (5), nullptr);
+    EXPECT_EQ (list.row_widget (4)->y(), 80);
+
+    // half a row: one more widget, only the new row is updated
+    list.set_scroll_position (10);
+    EXPECT_EQ (list.num_row_widgets(), 6);
+    EXPECT_EQ (model.updates, 6);
+    EXPECT_EQ (list.row_widget (0)->y(), -10);
+
+    // jump anywhere without creating widgets
+    list.scroll_to_row (54321);
+    EXPECT_EQ (list.scroll_position(), 54321 * 20);
+    EXPECT_EQ (list.num_row_widgets(), 6);
+    auto w = dynamic_cast<RowWidget*> (list.row_widget (54321));
+    ASSERT_NE (w, nullptr);
+    EXPECT_EQ (w->row, 54321);
+    EXPECT_EQ (w->y(), 0);
+    EXPECT_EQ (list.widget_at ({ 5.f, 25.f }), list.row_widget (54322));
+
+    // wheel: one line up
+    list.set_scroll_step (20);
+    EXPECT_TRUE (list.scroll (lui::ScrollEvent ({}, { 0.f, 1.f }, {})));
+    EXPECT_EQ (list.row_at (list.scroll_position()), 54320);
+
+    // clamped at the end
+    list.scroll_to_row (99999);
+    EXPECT_EQ (list.scroll_position(), 100000 * 20 - 100);
+    EXPECT_FALSE (list.scroll (lui::ScrollEvent ({}, { 0.f, -1.f }, {})));
+    EXPECT_EQ (model.created, 6);
+}
+
+TEST(ListView, variable_heights) {
+    Model model;
+    model.rows       = 1000;
+    model.tall_every = 10;
+    TestList list;
+    list.set_bounds (0, 0, 200, 100);
+    list.set_model (&model);
+
+    EXPECT_EQ (list.content_height(), 100 * 50 + 900 * 20);
+    EXPECT_EQ (list.row_position (10), 50 + 9 * 20);
+    EXPECT_EQ (list.row_at (50 + 9 * 20), 10);
+    EXPECT_EQ (list.row_at (50 + 9 * 20 + 49), 10);
+    EXPECT_EQ (list.row_at (50 + 9 * 20 + 50), 11);
+    EXPECT_EQ (list.row_at (-1), -1);
+    EXPECT_EQ (list.row_at (list.content_height()), -1);
+
+    model.tall_every = 0;
+    const auto queries = model.height_queries;
+    list.row_height_changed (10);
+    EXPECT_EQ (model.height_queries, queries + 1);
+    EXPECT_EQ (list.row_position (11), 11 * 20 + 30);
+    EXPECT_EQ (list.row_widget (1)->y(), 50);
+
+    list.set_model (nullptr);
+    EXPECT_EQ (list.num_rows(), 0);
+    EXPECT_EQ (list.num_row_widgets(), 0);
+}
@@ -0,0 +1,121 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "tests.hpp"
+
+#include "detail/message_queue.hpp"
+
+using lui::detail::MessageQueue;
+
+namespace {
+
+/** Push a callable the same way Main::post does. */
+template <class F>
+bool push (MessageQueue& queue, F fn) {
+    return queue.push (
+        [] (void* storage, bool run) {
+            struct Destroy {
+                F* f;
+                ~Destroy() { f->~F(); }
+            } destroy { static_cast<F*> (storage) };
+            if (run)
+                (*destroy.f)();
+        },
+        [] (void* storage, void* src) {
+            new (storage) F (std::move (*static_cast<F*> (src)));
+        },
+        &fn);
+}
+
+} // namespace
+
+TEST(MessageQueue, fifo_and_full) {
+    MessageQueue queue (4);
+    EXPECT_EQ (queue.capacity(), 4u);
+    EXPECT_FALSE (queue.pop());
+
+    std::vector<int> out;
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE (push (queue, [&out, i]() { out.push_back (i); }));
+    EXPECT_FALSE (push (queue, [&out]() { out.push_back (99); }));
+
+    EXPECT_EQ (queue.drain (2), 2u);
+    EXPECT_TRUE (push (queue, [&out]() { out.push_back (4); }));
+    EXPECT_EQ (queue.drain (100), 3u);
+    EXPECT_EQ (out, (std::vector<int> { 0, 1, 2, 3, 4 }));
+}
+
+TEST(MessageQueue, survives_throwing_message) {
+    MessageQueue queue (2);
+    auto counter = std::make_shared<int> (0);
+    std::vector<int> out;
+
+    for (int round = 0; round < 3; ++round) {
+        EXPECT_TRUE (push (queue, [counter]() { throw std::runtime_error ("posted"); }));
+        EXPECT_TRUE (push (queue, [&out, round]() { out.push_back (round); }));
+        EXPECT_EQ (queue.drain (100), 2u);
+    }
+
+    EXPECT_EQ (out, (std::vector<int> { 0, 1, 2 }));
+    EXPECT_EQ (counter.use_count(), 1);
+
+    EXPECT_TRUE (push (queue, [counter]() { throw 1; }));
+    EXPECT_THROW (queue.pop(), int);
+    EXPECT_EQ (counter.use_count(), 1);
+    EXPECT_TRUE (push (queue, [&out]() { out.push_back (3); }));
+    EXPECT_TRUE (push (queue, [&out]() { out.push_back (4); }));
+    EXPECT_EQ (queue.drain (100), 2u);
+    EXPECT_EQ (out.back(), 4);
+}
+
+TEST(MessageQueue, discards_on_destruction) {
+    auto counter = std::make_shared<int> (0);
+    {
+        MessageQueue queue (8);
+        push (queue, [counter]() { ++*counter; });
+        EXPECT_EQ (counter.use_count(), 2);
+    }
+    EXPECT_EQ (*counter, 0);
+    EXPECT_EQ (counter.use_count(), 1);
+}
+
+TEST(MessageQueue, multiple_producers) {
+    MessageQueue queue (256);
+    constexpr int num_threads = 4;
+    constexpr int per_thread  = 20000;
+
+    std::vector<int> last (num_threads, -1);
+    bool in_order = true;
+    int received  = 0;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back ([&, t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                auto msg = [&, t, i]() {
+                    in_order = in_order && last[t] == i - 1;
+                    last[t]  = i;
+                    ++received;
+                };
+                while (! push (queue, msg))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    while (received < num_threads * per_thread)
+        if (queue.drain (64) == 0)
+            std::this_thread::yield();
+
+    for (auto& t : threads)
+        t.join();
+
+    EXPECT_TRUE (in_order);
+    EXPECT_EQ (received, num_threads * per_thread);
+    EXPECT_FALSE (queue.pop());
+}
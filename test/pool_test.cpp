@@ -0,0 +1,68 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <memory>
+#include <thread>
+
+#include "tests.hpp"
+
+#include <lui/widget.hpp>
+
+#include "detail/pool.hpp"
+
+namespace pool = lui::detail::pool;
+
+TEST(Pool, reuse) {
+    const auto before = pool::current().stats.used_bytes;
+    auto a            = pool::allocate (40);
+    auto b            = pool::allocate (48);
+    EXPECT_EQ (pool::current().stats.used_bytes - before, LUI_POOL_ALLOCATION ? 96u : 0u);
+    EXPECT_NE (a, b);
+
+    pool::deallocate (a, 40);
+    EXPECT_EQ (pool::allocate (33), a);
+    pool::deallocate (a, 33);
+    pool::deallocate (b, 48);
+    EXPECT_EQ (pool::current().stats.used_bytes, before);
+
+    auto big = pool::allocate (pool::max_block + 1);
+    EXPECT_NE (big, nullptr);
+    pool::deallocate (big, pool::max_block + 1);
+}
+
+TEST(Pool, widgets) {
+    auto before = pool::current().stats.used_bytes;
+    {
+        auto w = std::make_unique<lui::Widget>();
+        lui::WidgetRef ref (w.get());
+        EXPECT_TRUE (ref.valid());
+        if (LUI_POOL_ALLOCATION) {
+            EXPECT_GT (pool::current().stats.used_bytes, before);
+        }
+        w.reset();
+        EXPECT_FALSE (ref.valid());
+    }
+    EXPECT_EQ (pool::current().stats.used_bytes, before);
+
+    std::shared_ptr<int> shared = std::allocate_shared<int> (pool::Allocator<int>(), 42);
+    EXPECT_EQ (*shared, 42);
+    shared.reset();
+    EXPECT_EQ (pool::current().stats.used_bytes, before);
+}
+
+TEST(Pool, ref_outlives_widget_on_another_thread) {
+    const auto before = pool::current().stats.used_bytes;
+    auto w            = std::make_unique<lui::Widget>();
+    lui::WidgetRef ref (w.get());
+    w.reset();
+    EXPECT_EQ (pool::current().stats.used_bytes, before);
+
+    // the last ref drops on a thread that never used the pool.
+    size_t other = 1;
+    std::thread ([&]() {
+        { auto dropped = std::move (ref); }
+        other = pool::current().stats.used_bytes;
+    }).join();
+    EXPECT_EQ (other, 0u);
+    EXPECT_EQ (pool::current().stats.used_bytes, before);
+}
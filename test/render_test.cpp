@@ -0,0 +1,249 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "tests.hpp"
+
+#include <lui/graphics.hpp>
+#include <lui/widget.hpp>
+
+#include "detail/render_list.hpp"
+#include "detail/widget.hpp"
+
+using lui::Bounds;
+
+namespace {
+
+/** Tracks the origin and clip, ignores drawing. */
+class Recorder : public NullContext {
+public:
+    struct State {
+        lui::Point<int> origin;
+        Bounds clip;
+    };
+
+    State state;
+    std::vector<State> stack;
+
+    explicit Recorder (Bounds clip) { state.clip = clip; }
+
+    void save() override { stack.push_back (state); }
+    void restore() override {
+        state = stack.back();
+        stack.pop_back();
+    }
+    void translate (double dx, double dy) override {
+        state.origin.x += (int) dx;
+        state.origin.y += (int) dy;
+        state.clip.x -= (int) dx;
+        state.clip.y -= (int) dy;
+    }
+    void clip (const Bounds& r) override { state.clip = state.clip.intersection (r); }
+    Bounds last_clip() const override { return state.clip; }
+};
+
+/** Records what it painted and where. */
+class Painted : public lui::Widget {
+public:
+    Painted (std::string n, std::vector<std::string>& l, bool opaque = false) : log (l) {
+        set_name (n);
+        set_opaque (opaque);
+        set_visible (true);
+    }
+
+    void paint (lui::Graphics& g) override {
+        auto clip = g.last_clip();
+        log.push_back (name() + " " + std::to_string (clip.width) + "x" + std::to_string (clip.height));
+    }
+
+    std::vector<std::string>& log;
+};
+
+} // namespace
+
+TEST(Render, paint_order) {
+    std::vector<std::string> log;
+    Painted root ("root", log), a ("a", log), b ("b", log), a1 ("a1", log);
+    root.set_bounds (0, 0, 100, 100);
+    a.set_bounds (0, 0, 50, 100);
+    b.set_bounds (40, 0, 60, 100);
+    a1.set_bounds (10, 10, 100, 10);
+    root.add (a);
+    root.add (b);
+    a.add (a1);
+
+    Recorder ctx (root.bounds());
+    lui::Graphics g (ctx);
+    root.render (g);
+
+    // a1 is clipped to a.
+    const std::vector<std::string> expected { "root 100x100", "a 50x100", "a1 40x10", "b 60x100" };
+    EXPECT_EQ (log, expected);
+    EXPECT_TRUE (ctx.stack.empty());
+}
+
+TEST(Render, occlusion) {
+    std::vector<std::string> log;
+    Painted root ("root", log), back ("back", log), left ("left", log, true), right ("right", log, true);
+    root.set_bounds (0, 0, 100, 100);
+    back.set_bounds (0, 0, 100, 100);
+    left.set_bounds (0, 0, 50, 100);
+    right.set_bounds (50, 0, 50, 100);
+    root.add (back);
+    root.add (left);
+    root.add (right);
+
+    // two opaque halves hide everything behind them.
+    Recorder ctx (root.bounds());
+    lui::Graphics g (ctx);
+    root.render (g);
+    std::vector<std::string> expected { "left 50x100", "right 50x100" };
+    EXPECT_EQ (log, expected);
+
+    // one pixel showing is enough to paint.
+    log.clear();
+    right.set_bounds (51, 0, 49, 100);
+    root.render (g);
+    expected = { "root 100x100", "back 100x100", "left 50x100", "right 49x100" };
+    EXPECT_EQ (log, expected);
+}
+
+TEST(Render, cached) {
+    std::vector<std::string> log;
+    Painted root ("root", log), a ("a", log), b ("b", log), b1 ("b1", log);
+    root.set_bounds (0, 0, 100, 100);
+    a.set_bounds (0, 0, 50, 100);
+    b.set_bounds (50, 0, 50, 100);
+    b1.set_bounds (10, 10, 20, 20);
+    root.add (a);
+    root.add (b);
+    b.add (b1);
+
+    lui::detail::RenderList list;
+    list.build (root);
+    EXPECT_FALSE (list.stale (root));
+    EXPECT_EQ (list.entries().size(), 4u);
+
+    // only what intersects the damaged area is painted.
+    Recorder ctx ({ 55, 50, 10, 10 });
+    lui::Graphics g (ctx);
+    list.render (g);
+    std::vector<std::string> expected { "root 10x10", "b 10x10" };
+    EXPECT_EQ (log, expected);
+
+    b1.set_bounds (10, 10, 20, 45);
+    EXPECT_TRUE (list.stale (root));
+    list.build (root);
+    log.clear();
+    list.render (g);
+    expected = { "root 10x10", "b 10x10", "b1 5x5" };
+    EXPECT_EQ (log, expected);
+}
+
+TEST(Render, coverage_mask) {
+    lui::detail::CoverageMask mask;
+    mask.reset ({ 0, 0, 100, 100 });
+    EXPECT_FALSE (mask.covers ({ 0, 0, 1, 1 }));
+
+    mask.add ({ 0, 0, 50, 100 });
+    mask.add ({ 50, 0, 50, 100 });
+    EXPECT_TRUE (mask.covers ({ 0, 0, 100, 100 }));
+    EXPECT_TRUE (mask.covers ({ -10, 20, 200, 10 }));
+
+    mask.reset ({ 10, 10, 100, 100 });
+    for (auto r : { Bounds { 10, 10, 100, 10 }, Bounds { 10, 100, 100, 10 }, Bounds { 10, 10, 10, 100 }, Bounds { 100, 10, 10, 100 } })
+        mask.add (r);
+    EXPECT_FALSE (mask.covers ({ 10, 10, 100, 100 }));
+    EXPECT_FALSE (mask.covers ({ 19, 19, 2, 2 }));
+    EXPECT_TRUE (mask.covers ({ 10, 10, 100, 5 }));
+    EXPECT_TRUE (mask.covers ({ 101, 30, 9, 60 }));
+
+    // big areas use coarser cells and only mark cells fully covered.
+    mask.reset ({ 0, 0, 4000, 4000 });
+    EXPECT_GT (mask.cell_size(), 1);
+    mask.add ({ 0, 0, 1001, 4000 });
+    EXPECT_TRUE (mask.covers ({ 0, 0, 1000 - mask.cell_size(), 4000 }));
+    EXPECT_FALSE (mask.covers ({ 0, 0, 1100, 10 }));
+}
+
+TEST(Render, frame_arena) {
+    /** Builds a path and a list in the frame arena. */
+    class Shapes : public lui::Widget {
+    public:
+        Shapes() { set_visible (true); }
+        void paint (lui::Graphics& g) override {
+            lui::FramePath path (&g.frame_arena());
+            for (int i = 0; i < 50; ++i)
+                path.add_ellipse (i * 2.f, 0.f, 10.f, 10.f);
+            g.fill_path (path);
+            std::pmr::vector<Bounds> cells (&g.frame_arena());
+            for (int i = 0; i < 20; ++i)
+                cells.push_back ({ i * 5, 0, 5, 5 });
+            for (auto& r : cells)
+                g.fill_rect (r);
+        }
+    };
+
+    Shapes root, a, b;
+    root.set_bounds (0, 0, 100, 100);
+    a.set_bounds (0, 0, 50, 100);
+    b.set_bounds (50, 0, 50, 100);
+    root.add (a);
+    root.add (b);
+
+    lui::FrameArena arena;
+    Recorder ctx (root.bounds());
+    for (int frame = 0; frame < 3; ++frame) {
+        lui::Graphics g (ctx, arena);
+        EXPECT_EQ (&g.frame_arena(), &arena);
+        root.render (g);
+        EXPECT_GE (arena.stats().allocations, 6u);
+        arena.reset();
+    }
+    EXPECT_EQ (arena.stats().heap_allocations, 1u);
+}
+
+TEST(Render, memory_stats) {
+    std::vector<std::string> log;
+    Painted root ("root", log), a ("a", log), b ("b", log), a1 ("a1", log);
+    root.set_bounds (0, 0, 100, 100);
+    a.set_bounds (0, 0, 50, 100);
+    b.set_bounds (50, 0, 50, 100);
+    a1.set_bounds (10, 10, 20, 20);
+    root.add (a);
+    root.add (b);
+    a.add (a1);
+
+    lui::MemoryStats before;
+    lui::detail::Widget::add_memory_stats (root, before);
+    EXPECT_EQ (before.num_widgets, 4u);
+    EXPECT_GT (before.widgets, 0u);
+
+    // rendering keeps a list on the root until trimmed.
+    Recorder ctx (root.bounds());
+    lui::Graphics g (ctx);
+    root.render (g);
+    lui::MemoryStats rendered;
+    lui::detail::Widget::add_memory_stats (root, rendered);
+    EXPECT_GT (rendered.widgets, before.widgets);
+
+    lui::detail::Widget::trim_render_lists (root);
+    lui::MemoryStats trimmed;
+    lui::detail::Widget::add_memory_stats (root, trimmed);
+    EXPECT_EQ (trimmed.widgets, before.widgets);
+
+    // and the next render builds it again.
+    log.clear();
+    root.render (g);
+    const std::vector<std::string> expected { "root 100x100", "a 50x100", "a1 20x20", "b 50x100" };
+    EXPECT_EQ (log, expected);
+
+    // contexts hold nothing unless they say so.
+    lui::MemoryStats context;
+    ctx.add_memory_stats (context);
+    ctx.trim_caches (lui::TrimLevel::ALL);
+    EXPECT_EQ (context.total(), 0u);
+}
@@ -0,0 +1,95 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "tests.hpp"
+
+#include <lui/slot_map.hpp>
+#include <lui/widget.hpp>
+
+TEST(SlotMap, stale_keys) {
+    lui::SlotMap<std::string> map;
+    EXPECT_FALSE (map.contains (lui::SlotKey()));
+
+    auto a = map.insert ("a");
+    auto b = map.insert ("b");
+    EXPECT_EQ (map.size(), 2u);
+    EXPECT_EQ (*map.find (a), "a");
+    EXPECT_EQ (*map.find (b), "b");
+
+    EXPECT_TRUE (map.erase (a));
+    EXPECT_FALSE (map.erase (a));
+    EXPECT_EQ (map.find (a), nullptr);
+
+    // the slot is reused but the old key stays stale.
+    auto c = map.insert ("c");
+    EXPECT_EQ (c.index, a.index);
+    EXPECT_NE (c, a);
+    EXPECT_EQ (map.find (a), nullptr);
+    EXPECT_EQ (*map.find (c), "c");
+
+    EXPECT_EQ (map.erase_if ([] (const std::string& s) { return s == "b"; }), 1u);
+    EXPECT_FALSE (map.contains (b));
+    EXPECT_EQ (map.size(), 1u);
+}
+
+TEST(SlotMap, weak_handles) {
+    lui::WeakHandles<lui::Widget> handles;
+    auto w   = std::make_unique<lui::Widget>();
+    auto key = handles.insert (w.get());
+    EXPECT_EQ (handles.lock (key), w.get());
+
+    w.reset();
+    EXPECT_EQ (handles.lock (key), nullptr);
+    EXPECT_EQ (handles.size(), 1u);
+    EXPECT_EQ (handles.purge(), 1u);
+    EXPECT_EQ (handles.size(), 0u);
+}
+
+TEST(SlotMap, widget_handle) {
+    lui::WidgetHandle empty;
+    EXPECT_FALSE (empty.valid());
+    EXPECT_TRUE (empty == nullptr);
+
+    auto w = std::make_unique<lui::Widget>();
+    auto h = w->handle();
+    lui::WidgetHandle copy (w.get());
+    EXPECT_TRUE (h.valid());
+    EXPECT_EQ (h.lock(), w.get());
+    EXPECT_TRUE (h == copy);
+    EXPECT_TRUE (h == w.get());
+    EXPECT_EQ (h.as<lui::Widget>(), w.get());
+
+    const auto key = h.key();
+    w.reset();
+    EXPECT_FALSE (h.valid());
+    EXPECT_FALSE (copy);
+
+    // a new widget may take the slot, never the handle.
+    auto other = std::make_unique<lui::Widget>();
+    EXPECT_EQ (h.lock(), nullptr);
+    if (other->handle().key().index == key.index) {
+        EXPECT_NE (other->handle().key(), key);
+    }
+}
+
+TEST(SlotMap, widget_handles_per_thread) {
+    auto w = std::make_unique<lui::Widget>();
+    auto h = w->handle();
+
+    // another thread has its own table, so its widgets can share keys.
+    lui::SlotKey key;
+    bool valid = false;
+    std::thread ([&]() {
+        lui::Widget other;
+        key   = other.handle().key();
+        valid = other.handle().valid();
+    }).join();
+
+    EXPECT_TRUE (valid);
+    EXPECT_EQ (key.index, 0u);
+    EXPECT_EQ (h.lock(), w.get());
+}
@@ -219,3 +219,63 @@ TEST(String, case_conversion) {
     EXPECT_EQ (mixed.to_lower(), "mixed case");
     EXPECT_EQ (mixed.to_upper(), "MIXED CASE");
 }
+
+TEST(String, utf8_simd_boundaries) {
+    using lui::String;
+
+    // multi-byte sequences straddling every 16 byte chunk boundary
+    for (size_t pad = 0; pad < 20; ++pad) {
+        std::string s (pad, 'a');
+        s += "é🎉中";
+        s += std::string (pad, 'b');
+        String str (s);
+        EXPECT_EQ (str.charCount(), pad * 2 + 3);
+        EXPECT_TRUE (str.valid_utf8());
+
+        // truncated sequence at the end
+        String cut (s.substr (0, pad + 3));
+        EXPECT_FALSE (cut.valid_utf8());
+
+        // stray continuation byte after a run of ASCII
+        std::string bad (pad + 16, 'x');
+        bad += '\x80';
+        EXPECT_FALSE (String (bad).valid_utf8());
+    }
+
+    EXPECT_TRUE (String (LOREM_IPSUM).valid_utf8());
+    EXPECT_EQ (String (LOREM_IPSUM).charCount(), std::strlen (LOREM_IPSUM));
+    EXPECT_FALSE (String ("\xF8\x88\x80\x80\x80").valid_utf8());
+}
+
+TEST(String, byte_offset) {
+    using lui::String;
+
+    String shortstr = "café!";
+    EXPECT_EQ (shortstr.byte_offset (0), 0u);
+    EXPECT_EQ (shortstr.byte_offset (3), 3u);
+    EXPECT_EQ (shortstr.byte_offset (4), 5u);
+    EXPECT_EQ (shortstr.byte_offset (99), shortstr.size());
+
+    // long enough to build the sparse index
+    std::string s;
+    for (int i = 0; i < 200; ++i)
+        s += (i % 3 == 0) ? "é" : "a";
+    String str (s);
+
+    size_t expected = 0;
+    for (size_t i = 0; i < 200; ++i) {
+        EXPECT_EQ (str.byte_offset (i), expected);
+        expected += (i % 3 == 0) ? 2 : 1;
+    }
+    EXPECT_EQ (str.byte_offset (200), str.size());
+    EXPECT_EQ (str.byte_offset (1000), str.size());
+
+    // modifying discards the index
+    EXPECT_EQ (str.byte_offset (150), 200u);
+    str = "🎉";
+    str << s.c_str();
+    EXPECT_EQ (str.byte_offset (1), 4u);
+    EXPECT_EQ (str.byte_offset (150), 203u);
+    str.clear();
+    EXPECT_EQ (str.byte_offset (1), 0u);
+}
@@ -0,0 +1,96 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include "tests.hpp"
+
+#include <lui/style.hpp>
+
+#include "detail/default_style.hpp"
+
+using lui::Color;
+using lui::ColorID;
+using lui::MetricID;
+
+TEST(Style, table) {
+    lui::detail::DefaultStyle style;
+    EXPECT_EQ (style.find_color (ColorID::BUTTON_BASE), Color (0xff464646));
+    EXPECT_FLOAT_EQ (style.find_metric (MetricID::SLIDER_THUMB_SIZE), 16.f);
+    EXPECT_FLOAT_EQ (style.find_font (lui::FontID::BUTTON).height(), 13.f);
+    EXPECT_EQ (style.find_color (1000), Color());
+    EXPECT_EQ (style.find_color (-1), Color());
+    EXPECT_FLOAT_EQ (style.find_metric (1000), 0.f);
+
+    // setting again replaces, and only a change bumps the version.
+    auto version = style.version();
+    style.set_color (ColorID::BUTTON_BASE, Color (0xff101010));
+    EXPECT_EQ (style.find_color (ColorID::BUTTON_BASE), Color (0xff101010));
+    EXPECT_EQ (style.version(), version + 1);
+    style.set_color (ColorID::BUTTON_BASE, Color (0xff101010));
+    style.set_metric (MetricID::SLIDER_THUMB_SIZE, 16.f);
+    EXPECT_EQ (style.version(), version + 1);
+}
+
+TEST(Style, large_ids) {
+    lui::detail::DefaultStyle style;
+    const int big = 0x7fffffff;
+    EXPECT_EQ (style.find_color (big), Color());
+
+    auto version = style.version();
+    style.set_color (big, Color (0xff123456));
+    style.set_metric (big - 1, 3.f);
+    EXPECT_EQ (style.find_color (big), Color (0xff123456));
+    EXPECT_FLOAT_EQ (style.find_metric (big - 1), 3.f);
+    EXPECT_FLOAT_EQ (style.find_metric (big), 0.f);
+    EXPECT_EQ (style.version(), version + 2);
+
+    style.set_color (big, Color (0xff123456));
+    EXPECT_EQ (style.version(), version + 2);
+
+    // the boundary between the array and the map.
+    style.set_color (1023, Color (0xff000001));
+    style.set_color (1024, Color (0xff000002));
+    EXPECT_EQ (style.find_color (1023), Color (0xff000001));
+    EXPECT_EQ (style.find_color (1024), Color (0xff000002));
+}
+
+TEST(Style, uses) {
+    lui::detail::DefaultStyle style;
+    uint64_t base = 0, thumb = 0;
+
+    auto outer = lui::Style::record_uses (&base);
+    style.find_color (ColorID::BUTTON_BASE);
+    lui::Style::record_uses (&thumb);
+    style.find_metric (MetricID::SLIDER_THUMB_SIZE);
+    lui::Style::record_uses (outer);
+    style.find_color (ColorID::SLIDER_BASE); // recorded nowhere
+
+    EXPECT_NE (base, 0u);
+    EXPECT_NE (thumb, 0u);
+    EXPECT_NE (base, thumb);
+}
+
+TEST(Style, cache) {
+    lui::detail::DefaultStyle style;
+    lui::StyleCache<Color> hover;
+    int resolved = 0;
+    auto resolve = [&] (const lui::Style& s) {
+        ++resolved;
+        return s.find_color (ColorID::BUTTON_BASE).brighter (0.1f);
+    };
+
+    uint64_t first = 0, second = 0;
+    auto outer = lui::Style::record_uses (&first);
+    const auto c = hover.get (style, resolve);
+    lui::Style::record_uses (&second);
+    EXPECT_EQ (hover.get (style, resolve), c);
+    lui::Style::record_uses (outer);
+
+    // a hit still marks what the value was resolved from.
+    EXPECT_EQ (resolved, 1);
+    EXPECT_NE (first, 0u);
+    EXPECT_EQ (first, second);
+
+    style.set_color (ColorID::BUTTON_BASE, Color (0xff202020));
+    EXPECT_NE (hover.get (style, resolve), c);
+    EXPECT_EQ (resolved, 2);
+}
@@ -4,3 +4,33 @@
 #pragma once
 
 #include <gtest/gtest.h>
+
+#include <lui/graphics.hpp>
+
+/** A drawing context that draws nothing. Tests override what they watch. */
+class NullContext : public lui::DrawingContext {
+public:
+    double device_scale() const noexcept override { return 1.0; }
+    void save() override {}
+    void restore() override {}
+    void set_line_width (double) override {}
+    void clear_path() override {}
+    void move_to (double, double) override {}
+    void line_to (double, double) override {}
+    void quad_to (double, double, double, double) override {}
+    void cubic_to (double, double, double, double, double, double) override {}
+    void close_path() override {}
+    void fill() override {}
+    void stroke() override {}
+    void translate (double, double) override {}
+    void transform (const lui::Transform&) override {}
+    void clip (const lui::Bounds&) override {}
+    void exclude_clip (const lui::Bounds&) override {}
+    lui::Bounds last_clip() const override { return {}; }
+    lui::Font font() const noexcept override { return {}; }
+    void set_font (const lui::Font&) override {}
+    void set_fill (const lui::Fill&) override {}
+    void fill_rect (const lui::Rectangle<double>&) override {}
+    lui::FontMetrics font_metrics() const noexcept override { return {}; }
+    lui::TextMetrics text_metrics (std::string_view) const noexcept override { return {}; }
+};
@@ -0,0 +1,112 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <thread>
+
+#include "tests.hpp"
+
+#include <lui/slider.hpp>
+#include <lui/value_channel.hpp>
+
+#include "detail/frame.hpp"
+
+using lui::ValueChannel;
+using lui::detail::FrameTasks;
+
+namespace {
+
+struct Levels {
+    double peak;
+    double negated;
+    int64_t count;
+};
+
+} // namespace
+
+TEST(ValueChannel, read_write) {
+    ValueChannel<double> channel (0.5);
+    EXPECT_EQ (channel.read(), 0.5);
+
+    uint64_t version = channel.version();
+    double value     = 0.0;
+    EXPECT_FALSE (channel.read (value, version));
+    EXPECT_EQ (value, 0.0);
+
+    channel.write (0.75);
+    EXPECT_NE (channel.version(), version);
+    EXPECT_TRUE (channel.read (value, version));
+    EXPECT_EQ (value, 0.75);
+    EXPECT_EQ (version, channel.version());
+    EXPECT_FALSE (channel.read (value, version));
+}
+
+TEST(ValueChannel, threaded) {
+    ValueChannel<Levels> channel (Levels { 0.0, -0.0, 0 });
+    constexpr int64_t num_writes = 200000;
+
+    std::thread writer ([&]() {
+        for (int64_t i = 1; i <= num_writes; ++i)
+            channel.write (Levels { double (i), -double (i), i });
+    });
+
+    int64_t last     = 0;
+    uint64_t version = 0;
+    Levels levels;
+    while (last < num_writes) {
+        if (! channel.read (levels, version))
+            continue;
+        ASSERT_EQ (levels.peak, -levels.negated);
+        ASSERT_EQ (levels.peak, double (levels.count));
+        ASSERT_GE (levels.count, last);
+        last = levels.count;
+    }
+
+    writer.join();
+    EXPECT_EQ (channel.read().count, num_writes);
+}
+
+TEST(FrameTasks, tick) {
+    FrameTasks tasks;
+    int runs = 0;
+    tasks.add ([&] (double) { return ++runs < 3; });
+    EXPECT_EQ (tasks.size(), 1u);
+
+    EXPECT_TRUE (tasks.tick (1.0));
+    EXPECT_FALSE (tasks.tick (1.0 + FrameTasks::min_interval * 0.5));
+    EXPECT_EQ (runs, 1);
+    EXPECT_TRUE (tasks.tick (1.1));
+    EXPECT_TRUE (tasks.tick (1.2));
+    EXPECT_EQ (runs, 3);
+    EXPECT_EQ (tasks.size(), 0u);
+}
+
+TEST(Ranged, bind) {
+    auto channel = std::make_shared<ValueChannel<double>> (0.25);
+    lui::Slider slider;
+    int changes = 0;
+    slider.on_value_changed = [&]() { ++changes; };
+
+    auto& tasks = FrameTasks::current();
+    double now  = 1000.0;
+    slider.bind (channel, 0.1);
+    EXPECT_EQ (slider.bound_channel(), channel.get());
+    tasks.tick (now += 1.0);
+    EXPECT_EQ (slider.value(), 0.25);
+
+    channel->write (0.3);
+    tasks.tick (now += 1.0);
+    EXPECT_EQ (slider.value(), 0.25);
+
+    channel->write (0.5);
+    tasks.tick (now += 1.0);
+    EXPECT_EQ (slider.value(), 0.5);
+    EXPECT_EQ (changes, 0);
+
+    const auto count = tasks.size();
+    slider.bind (nullptr);
+    EXPECT_EQ (slider.bound_channel(), nullptr);
+    channel->write (0.9);
+    tasks.tick (now += 1.0);
+    EXPECT_EQ (slider.value(), 0.5);
+    EXPECT_EQ (tasks.size(), count - 1);
+}
@@ -0,0 +1,71 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <memory>
+#include <vector>
+
+#include "tests.hpp"
+
+#include <lui/viewport.hpp>
+
+namespace {
+
+class Row : public lui::Widget {
+public:
+    bool obstructed (int, int) override { return true; }
+};
+
+class TestViewport : public lui::Viewport {
+public:
+    using lui::Viewport::scroll;
+};
+
+} // namespace
+
+TEST(Viewport, scroll_and_hit_test) {
+    TestViewport vp;
+    lui::Widget content;
+    std::vector<std::unique_ptr<Row>> rows;
+
+    vp.set_bounds (0, 0, 100, 100);
+    vp.set_visible (true);
+    content.set_size (100, 1000 * 20);
+    content.set_visible (true);
+    for (int i = 0; i < 1000; ++i) {
+        rows.push_back (std::make_unique<Row>());
+        rows.back()->set_bounds (0, i * 20, 100, 20);
+        rows.back()->set_visible (true);
+        content.add (*rows.back());
+    }
+
+    vp.set_content (&content);
+    EXPECT_EQ (vp.content(), &content);
+    EXPECT_EQ (vp.widget_at ({ 10.f, 10.f }), rows[0].get());
+
+    vp.set_view_position (0, 500);
+    EXPECT_EQ (content.y(), -500);
+    EXPECT_EQ (vp.view_area(), (lui::Bounds { 0, 500, 100, 100 }));
+    EXPECT_EQ (vp.widget_at ({ 10.f, 10.f }), rows[25].get());
+    EXPECT_EQ (vp.widget_at ({ 10.f, 150.f }), nullptr);
+
+    // one line up, one line down
+    vp.set_scroll_step (20);
+    EXPECT_TRUE (vp.scroll (lui::ScrollEvent ({}, { 0.f, 1.f }, {})));
+    EXPECT_EQ (vp.view_position().y, 480);
+    EXPECT_TRUE (vp.scroll (lui::ScrollEvent ({}, { 0.f, -2.f }, {})));
+    EXPECT_EQ (vp.view_position().y, 520);
+
+    // clamped, and unhandled at the edges so parents can scroll
+    vp.set_view_position (0, 1000000);
+    EXPECT_EQ (vp.view_position().y, 1000 * 20 - 100);
+    EXPECT_FALSE (vp.scroll (lui::ScrollEvent ({}, { 0.f, -1.f }, {})));
+    EXPECT_FALSE (vp.scroll (lui::ScrollEvent ({}, { 1.f, 0.f }, {})));
+
+    // content shrinking re-clamps
+    content.set_size (100, 150);
+    EXPECT_EQ (vp.view_position().y, 50);
+
+    vp.set_content (nullptr);
+    EXPECT_EQ (vp.content(), nullptr);
+    EXPECT_EQ (content.parent(), nullptr);
+}
@@ -0,0 +1,43 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "tests.hpp"
+
+#include "detail/waker.hpp"
+
+using lui::detail::Waker;
+
+TEST(Waker, runs_on_its_own_thread) {
+    std::atomic<int> runs { 0 };
+    std::atomic<bool> other_thread { false };
+    const auto caller = std::this_thread::get_id();
+    {
+        Waker waker ([&]() {
+            other_thread = std::this_thread::get_id() != caller;
+            ++runs;
+        });
+
+        std::thread ([&]() { waker.wake(); }).join();
+        for (int i = 0; i < 500 && runs.load() == 0; ++i)
+            std::this_thread::sleep_for (std::chrono::milliseconds (2));
+        EXPECT_GE (runs.load(), 1);
+        EXPECT_TRUE (other_thread.load());
+
+        // many signals before it runs are merged, and none are lost.
+        for (int i = 0; i < 1000; ++i)
+            waker.wake();
+        for (int i = 0; i < 500 && runs.load() < 2; ++i)
+            std::this_thread::sleep_for (std::chrono::milliseconds (2));
+        EXPECT_GE (runs.load(), 2);
+        EXPECT_LT (runs.load(), 1001);
+    }
+
+    // stopped on destruction without running again.
+    const auto after = runs.load();
+    std::this_thread::sleep_for (std::chrono::milliseconds (10));
+    EXPECT_EQ (runs.load(), after);
+}
@@ -0,0 +1,204 @@
+// Copyright 2026 Kushview, LLC
+// SPDX-License-Identifier: ISC
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "tests.hpp"
+
+#include <lui/widget.hpp>
+
+using lui::Point;
+using lui::Widget;
+
+#define EXPECT_POINT(a, ex, ey)     \
+    do {                            \
+        const auto p_ = (a);        \
+        EXPECT_FLOAT_EQ (p_.x, ex); \
+        EXPECT_FLOAT_EQ (p_.y, ey); \
+    } while (0)
+
+TEST(Widget, convert) {
+    Widget root, a, b, a1, b1;
+    root.set_bounds (5, 5, 400, 400);
+    a.set_bounds (10, 20, 100, 100);
+    b.set_bounds (200, 30, 100, 100);
+    a1.set_bounds (3, 4, 10, 10);
+    b1.set_bounds (7, 8, 10, 10);
+    root.add (a);
+    root.add (b);
+    a.add (a1);
+    b.add (b1);
+
+    const Point<float> pt { 1.f, 2.f };
+    EXPECT_POINT (a1.convert (&a1, pt), 1.f, 2.f);
+    EXPECT_POINT (a1.convert (&a, pt), -2.f, -2.f);
+    EXPECT_POINT (a.convert (&a1, pt), 4.f, 6.f);
+    EXPECT_POINT (b1.convert (&a1, pt), 1.f + 13.f - 207.f, 2.f + 24.f - 38.f);
+    EXPECT_POINT (a1.to_view_space (pt), 19.f, 31.f);
+
+    // moving an ancestor invalidates cached offsets
+    a.set_bounds (50, 60, 100, 100);
+    EXPECT_POINT (a1.to_view_space (pt), 59.f, 71.f);
+
+    // so does reparenting
+    b.add (a1);
+    EXPECT_POINT (a1.to_view_space (pt), 209.f, 41.f);
+    EXPECT_POINT (b1.convert (&a1, pt), -3.f, -2.f);
+}
+
+namespace {
+
+class Tracked : public Widget {
+public:
+    int moves = 0, resizes = 0, children = 0, structures = 0;
+    std::function<void()> on_resized;
+
+protected:
+    void moved() override { ++moves; }
+    void resized() override {
+        ++resizes;
+        if (on_resized)
+            on_resized();
+    }
+    void children_changed() override { ++children; }
+    void parent_structure_changed() override { ++structures; }
+};
+
+class Solid : public Widget {
+public:
+    bool obstructed (int, int) override { return true; }
+};
+
+} // namespace
+
+TEST(Widget, update_batch) {
+    Tracked root, a, b, a1;
+    {
+        Widget::UpdateBatch batch;
+        root.add (a);
+        root.add (b);
+        a.add (a1);
+        a.set_bounds (0, 0, 10, 10);
+        a.set_bounds (5, 5, 20, 20);
+        a1.set_bounds (1, 1, 5, 5);
+
+        // state changes right away, notifications wait
+        EXPECT_EQ (a.parent(), &root);
+        EXPECT_EQ (a.width(), 20);
+        EXPECT_EQ (root.children, 0);
+        EXPECT_EQ (a.resizes, 0);
+        EXPECT_EQ (a1.structures, 0);
+
+        {
+            Widget::UpdateBatch nested;
+            b.set_bounds (1, 2, 3, 4);
+        }
+        EXPECT_EQ (b.resizes, 0);
+    }
+
+    EXPECT_EQ (root.children, 1);
+    EXPECT_EQ (a.children, 1);
+    EXPECT_EQ (a.resizes, 1);
+    EXPECT_EQ (a.moves, 1);
+    EXPECT_EQ (a.structures, 1);
+    EXPECT_EQ (a1.structures, 1);
+    EXPECT_EQ (b.resizes, 1);
+}
+
+TEST(Widget, update_batch_cascade) {
+    Tracked root, child;
+    root.add (child);
+    root.on_resized = [&]() { child.set_bounds (0, 0, root.width() / 2, root.height()); };
+
+    Widget::UpdateBatch batch;
+    root.set_bounds (0, 0, 100, 100);
+    root.set_bounds (0, 0, 200, 100);
+    EXPECT_EQ (root.resizes, 0);
+    batch.commit();
+
+    EXPECT_EQ (root.resizes, 1);
+    EXPECT_EQ (child.resizes, 1);
+    EXPECT_EQ (child.width(), 100);
+
+    // removed then deleted before the batch ends
+    {
+        Widget::UpdateBatch batch2;
+        auto temp = std::make_unique<Tracked>();
+        root.add (*temp);
+        root.remove (*temp);
+        temp.reset();
+    }
+    EXPECT_EQ (root.children, 2);
+}
+
+TEST(Widget, stacking) {
+    Solid root, a, b, c, d;
+    root.add (a);
+    root.add (b);
+    root.add (c);
+    EXPECT_EQ (root.num_children(), 3u);
+    EXPECT_EQ (root.child_at (0), &a);
+    EXPECT_EQ (root.child_at (2), &c);
+    EXPECT_EQ (root.child_at (3), nullptr);
+
+    a.to_front();
+    EXPECT_EQ (root.child_at (2), &a);
+    a.to_back();
+    EXPECT_EQ (root.child_at (0), &a);
+
+    // higher z stays in front of lower, whatever the add order.
+    c.set_z_order (1);
+    EXPECT_EQ (root.child_at (2), &c);
+    d.set_z_order (-1);
+    root.add (d);
+    EXPECT_EQ (root.child_at (0), &d);
+    b.to_front();
+    EXPECT_EQ (root.child_at (2), &b);
+    EXPECT_EQ (root.child_at (3), &c);
+
+    // front most gets input.
+    for (Widget* w : { &root, &a, &b, &c, &d }) {
+        w->set_bounds (0, 0, 10, 10);
+        w->set_visible (true);
+    }
+    EXPECT_EQ (root.widget_at ({ 5.f, 5.f }), &c);
+    c.set_z_order (-2);
+    EXPECT_EQ (root.child_at (0), &c);
+    EXPECT_EQ (root.widget_at ({ 5.f, 5.f }), &b);
+
+    // removing from the middle keeps order.
+    root.remove (d);
+    root.remove (a);
+    EXPECT_EQ (root.num_children(), 2u);
+    EXPECT_EQ (root.child_at (0), &c);
+    EXPECT_EQ (root.child_at (1), &b);
+    EXPECT_EQ (a.parent(), nullptr);
+}
+
+TEST(Widget, add_remove_all) {
+    Tracked root;
+    std::vector<std::unique_ptr<Widget>> owned;
+    std::vector<Widget*> kids;
+    for (int i = 0; i < 100; ++i)
+        kids.push_back (owned.emplace_back (std::make_unique<Widget>()).get());
+
+    root.add_all (kids);
+    EXPECT_EQ (root.children, 1);
+    EXPECT_EQ (root.num_children(), 100u);
+
+    std::vector<Widget*> evens;
+    for (size_t i = 0; i < kids.size(); i += 2)
+        evens.push_back (kids[i]);
+    root.remove_all (evens);
+    EXPECT_EQ (root.children, 2);
+    EXPECT_EQ (root.num_children(), 50u);
+    for (size_t i = 0; i < 50; ++i)
+        EXPECT_EQ (root.child_at (i), kids[i * 2 + 1]);
+
+    root.remove_all();
+    EXPECT_EQ (root.children, 3);
+    EXPECT_EQ (root.num_children(), 0u);
+    EXPECT_EQ (kids[1]->parent(), nullptr);
+}